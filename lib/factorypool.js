@@ -0,0 +1,85 @@
+'use strict';
+
+const os = require('os');
+
+const { RTCPeerConnectionFactory } = require('./binding');
+
+const strategies = ['round-robin', 'least-loaded'];
+
+/**
+ * An RTCPeerConnectionFactoryPool shards RTCPeerConnections across several
+ * RTCPeerConnectionFactories, and therefore across several network, worker,
+ * and signaling threads.
+ */
+function RTCPeerConnectionFactoryPool(options) {
+  options = Object.assign({
+    size: os.cpus().length,
+    strategy: 'round-robin',
+    pinThreads: false,
+    factoryOptions: {}
+  }, options);
+
+  if (!Number.isInteger(options.size) || options.size < 1) {
+    throw new TypeError('Expected a .size greater than 0, not ' + options.size);
+  } else if (strategies.indexOf(options.strategy) === -1) {
+    throw new TypeError('Expected a .strategy of "' + strategies.join('" or "') + '", not "' + options.strategy + '"');
+  }
+
+  const cpus = os.cpus().length;
+
+  const factories = [];
+  for (let i = 0; i < options.size; i++) {
+    const factoryOptions = Object.assign({
+      threadNamePrefix: 'RTCPeerConnectionFactoryPool:' + i
+    }, options.factoryOptions);
+    if (options.pinThreads) {
+      const affinity = [i % cpus];
+      factoryOptions.networkThreadAffinity = affinity;
+      factoryOptions.workerThreadAffinity = affinity;
+      factoryOptions.signalingThreadAffinity = affinity;
+    }
+    factories.push(new RTCPeerConnectionFactory(factoryOptions));
+  }
+
+  Object.defineProperties(this, {
+    _factories: {
+      value: factories
+    },
+    _next: {
+      value: 0,
+      writable: true
+    },
+    factories: {
+      get() {
+        return factories.slice();
+      },
+      enumerable: true
+    },
+    strategy: {
+      value: options.strategy,
+      enumerable: true
+    }
+  });
+}
+
+/**
+ * Get the RTCPeerConnectionFactory to use for the next RTCPeerConnection.
+ * "round-robin" cycles through the factories; "least-loaded" picks the factory
+ * with the fewest open RTCPeerConnections, breaking ties in round-robin order.
+ */
+RTCPeerConnectionFactoryPool.prototype.next = function next() {
+  const factories = this._factories;
+  let index = this._next;
+  if (this.strategy === 'least-loaded') {
+    for (let i = 1; i < factories.length; i++) {
+      const candidate = (this._next + i) % factories.length;
+      if (factories[candidate].peerConnectionCount < factories[index].peerConnectionCount) {
+        index = candidate;
+      }
+    }
+  }
+  this._next = (index + 1) % factories.length;
+  return factories[index];
+};
+
+module.exports = RTCPeerConnectionFactoryPool;
@@ -5,11 +5,13 @@ const { inherits } = require('util');
 const {
   MediaStream,
   MediaStreamTrack,
+  RTCAudioMixer,
   RTCAudioSink,
   RTCAudioSource,
   RTCDataChannel,
   RTCDtlsTransport,
   RTCIceTransport,
+  RTCPeerConnectionFactory,
   RTCRtpReceiver,
   RTCRtpSender,
   RTCRtpTransceiver,
@@ -26,6 +28,7 @@ const EventTarget = require('./eventtarget');
 
 inherits(MediaStream, EventTarget);
 inherits(MediaStreamTrack, EventTarget);
+inherits(RTCAudioMixer, EventTarget);
 inherits(RTCAudioSink, EventTarget);
 inherits(RTCDataChannel, EventTarget);
 inherits(RTCDtlsTransport, EventTarget);
@@ -50,8 +53,11 @@ RTCDataChannel.prototype.send = function send(data) {
 
 const nonstandard = {
   i420ToRgba,
+  RTCAudioMixer,
   RTCAudioSink,
   RTCAudioSource,
+  RTCPeerConnectionFactory,
+  RTCPeerConnectionFactoryPool: require('./factorypool'),
   RTCVideoSink,
   RTCVideoSource,
   rgbaToI420
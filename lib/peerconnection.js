@@ -40,6 +40,16 @@ function RTCPeerConnection() {
     self.dispatchEvent(new RTCPeerConnectionIceEvent('icecandidate', { candidate: icecandidate }));
   };
 
+  pc.onicecandidates = function onicecandidates(candidates, complete) {
+    self.dispatchEvent({
+      type: 'icecandidates',
+      candidates: candidates.map(function(candidate) {
+        return new RTCIceCandidate(candidate);
+      }),
+      complete: complete
+    });
+  };
+
   pc.onicecandidateerror = function onicecandidateerror(eventInitDict) {
     var pair = eventInitDict.hostCandidate.split(':');
     eventInitDict.address = pair[0];
@@ -69,6 +79,11 @@ function RTCPeerConnection() {
     self.dispatchEvent({ type: 'negotiationneeded' });
   };
 
+  pc.onstats = function onstats(delta) {
+    delta.type = 'stats';
+    self.dispatchEvent(delta);
+  };
+
   // [ToDo] onnegotiationneeded
 
   pc.ondatachannel = function ondatachannel(channel) {
@@ -95,43 +110,49 @@ function RTCPeerConnection() {
     },
     currentLocalDescription: {
       get: function getCurrentLocalDescription() {
-        return pc.currentLocalDescription
-          ? new RTCSessionDescription(pc.currentLocalDescription)
+        var description = pc.currentLocalDescription;
+        return description
+          ? new RTCSessionDescription(description)
           : null;
       }
     },
     localDescription: {
       get: function getLocalDescription() {
-        return pc.localDescription
-          ? new RTCSessionDescription(pc.localDescription)
+        var description = pc.localDescription;
+        return description
+          ? new RTCSessionDescription(description)
           : null;
       }
     },
     pendingLocalDescription: {
       get: function getPendingLocalDescription() {
-        return pc.pendingLocalDescription
-          ? new RTCSessionDescription(pc.pendingLocalDescription)
+        var description = pc.pendingLocalDescription;
+        return description
+          ? new RTCSessionDescription(description)
           : null;
       }
     },
     currentRemoteDescription: {
       get: function getCurrentRemoteDescription() {
-        return pc.currentRemoteDescription
-          ? new RTCSessionDescription(pc.currentRemoteDescription)
+        var description = pc.currentRemoteDescription;
+        return description
+          ? new RTCSessionDescription(description)
           : null;
       }
     },
     remoteDescription: {
       get: function getRemoteDescription() {
-        return pc.remoteDescription
-          ? new RTCSessionDescription(pc.remoteDescription)
+        var description = pc.remoteDescription;
+        return description
+          ? new RTCSessionDescription(description)
           : null;
       }
     },
     pendingRemoteDescription: {
       get: function getPendingRemoteDescription() {
-        return pc.pendingRemoteDescription
-          ? new RTCSessionDescription(pc.pendingRemoteDescription)
+        var description = pc.pendingRemoteDescription;
+        return description
+          ? new RTCSessionDescription(description)
           : null;
       }
     },
@@ -168,6 +189,10 @@ function RTCPeerConnection() {
       value: null,
       writable: true
     },
+    onicecandidates: {
+      value: null,
+      writable: true
+    },
     oniceconnectionstatechange: {
       value: null,
       writable: true
@@ -183,6 +208,10 @@ function RTCPeerConnection() {
     onsignalingstatechange: {
       value: null,
       writable: true
+    },
+    onstats: {
+      value: null,
+      writable: true
     }
   });
 }
@@ -192,6 +221,12 @@ inherits(RTCPeerConnection, EventTarget);
 // NOTE(mroberts): This is a bit of a hack.
 RTCPeerConnection.prototype.ontrack = null;
 
+RTCPeerConnection.collectStats = function collectStats(connections, filter) {
+  return _webrtc.RTCPeerConnection.collectStats(Array.prototype.map.call(connections, function(connection) {
+    return connection instanceof RTCPeerConnection ? connection._pc : connection;
+  }), filter);
+};
+
 RTCPeerConnection.prototype.addIceCandidate = function addIceCandidate(candidate) {
   var promise = this._pc.addIceCandidate(candidate);
   if (arguments.length === 3) {
@@ -200,6 +235,10 @@ RTCPeerConnection.prototype.addIceCandidate = function addIceCandidate(candidate
   return promise;
 };
 
+RTCPeerConnection.prototype.addIceCandidates = function addIceCandidates(candidates) {
+  return this._pc.addIceCandidates(candidates);
+};
+
 RTCPeerConnection.prototype.addTransceiver = function addTransceiver() {
   return this._pc.addTransceiver.apply(this._pc, arguments);
 };
@@ -259,7 +298,33 @@ RTCPeerConnection.prototype.getStats = function getStats() {
     this._pc.legacyGetStats().then(arguments[0], arguments[1]);
     return;
   }
-  return this._pc.getStats();
+  // The optional argument is a nonstandard RTCStatsFilter. A null selector
+  // selects everything, as it does in the standard getStats.
+  return this._pc.getStats(arguments[0] === null ? undefined : arguments[0]);
+};
+
+RTCPeerConnection.prototype.getLegacyStats = function getLegacyStats() {
+  return this._pc.legacyGetStats(true);
+};
+
+RTCPeerConnection.prototype.getStatsBuffer = function getStatsBuffer(filter) {
+  return this._pc.getStatsBuffer(filter);
+};
+
+RTCPeerConnection.prototype.subscribeStats = function subscribeStats(options) {
+  this._pc.subscribeStats(options);
+};
+
+RTCPeerConnection.prototype.unsubscribeStats = function unsubscribeStats() {
+  this._pc.unsubscribeStats();
+};
+
+RTCPeerConnection.prototype.batchIceCandidates = function batchIceCandidates(windowMs) {
+  this._pc.batchIceCandidates(windowMs);
+};
+
+RTCPeerConnection.prototype.unbatchIceCandidates = function unbatchIceCandidates() {
+  this._pc.unbatchIceCandidates();
 };
 
 RTCPeerConnection.prototype.removeTrack = function removeTrack(sender) {
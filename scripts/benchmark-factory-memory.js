@@ -0,0 +1,83 @@
+#!/usr/bin/env node
+/* eslint no-console:0, no-process-env:0, no-process-exit:0 */
+'use strict';
+
+// Measures the memory used by RTCPeerConnections with data channels, with and
+// without RTCPeerConnectionFactory's `dataChannelsOnly` option. Each mode runs
+// in its own process, so that neither pays for the other's factory.
+//
+//   node scripts/benchmark-factory-memory.js [count]
+
+const { spawnSync } = require('child_process');
+
+const COUNT = parseInt(process.argv[2] || process.env.COUNT || '1000', 10);
+
+function mb(bytes) {
+  return (bytes / 1024 / 1024).toFixed(1) + ' MB';
+}
+
+function measure(dataChannelsOnly, count) {
+  const { RTCPeerConnection, nonstandard } = require('..');
+  const { RTCPeerConnectionFactory } = nonstandard;
+
+  global.gc();
+  const before = process.memoryUsage().rss;
+
+  const factory = new RTCPeerConnectionFactory({ dataChannelsOnly });
+  const pcs = [];
+  for (let i = 0; i < count; i++) {
+    const pc = new RTCPeerConnection({ factory });
+    pc.createDataChannel('benchmark');
+    pcs.push(pc);
+  }
+
+  return Promise.all(pcs.map(pc => pc.createOffer().then(offer => pc.setLocalDescription(offer)))).then(() => {
+    global.gc();
+    const after = process.memoryUsage().rss;
+    pcs.forEach(pc => pc.close());
+    return {
+      dataChannelsOnly,
+      count,
+      rss: after - before,
+      initializationTime: factory.initializationTime
+    };
+  });
+}
+
+function child() {
+  const dataChannelsOnly = process.env.DATA_CHANNELS_ONLY === 'true';
+  measure(dataChannelsOnly, COUNT).then(result => {
+    console.log(JSON.stringify(result));
+    process.exit(0);
+  }, error => {
+    console.error(error);
+    process.exit(1);
+  });
+}
+
+function parent() {
+  console.log('Creating ' + COUNT + ' RTCPeerConnections with a data channel each\n');
+  [false, true].forEach(dataChannelsOnly => {
+    const result = spawnSync(process.execPath, ['--expose-gc', __filename, String(COUNT)], {
+      env: Object.assign({}, process.env, {
+        BENCHMARK_CHILD: 'true',
+        DATA_CHANNELS_ONLY: String(dataChannelsOnly)
+      }),
+      stdio: ['ignore', 'pipe', 'inherit']
+    });
+    if (result.status) {
+      throw new Error('Benchmark failed');
+    }
+    const lines = result.stdout.toString().trim().split('\n');
+    const { rss, initializationTime } = JSON.parse(lines[lines.length - 1]);
+    console.log('dataChannelsOnly: ' + dataChannelsOnly);
+    console.log('  factory initialization: ' + initializationTime.toFixed(1) + ' ms');
+    console.log('  RSS: ' + mb(rss) + ' (' + mb(rss / COUNT * 1000) + ' per 1000 RTCPeerConnections)\n');
+  });
+}
+
+if (process.env.BENCHMARK_CHILD) {
+  child();
+} else {
+  parent();
+}
@@ -0,0 +1,121 @@
+#!/usr/bin/env node
+/* eslint no-console:0, no-process-env:0, no-process-exit:0 */
+'use strict';
+
+// Measures RTCDataChannel throughput between two RTCPeerConnections over
+// loopback, with and without RTCPeerConnectionFactory's `udpBatching` option.
+// Each mode runs in its own process.
+//
+//   node scripts/benchmark-udp-batching.js [megabytes]
+
+const { spawnSync } = require('child_process');
+
+const MEGABYTES = parseInt(process.argv[2] || process.env.MEGABYTES || '256', 10);
+const CHUNK_SIZE = 16 * 1024;
+const HIGH_WATER_MARK = 1024 * 1024;
+
+function connect(pc1, pc2) {
+  pc1.onicecandidate = ({ candidate }) => candidate && pc2.addIceCandidate(candidate);
+  pc2.onicecandidate = ({ candidate }) => candidate && pc1.addIceCandidate(candidate);
+  return pc1.createOffer()
+    .then(offer => pc1.setLocalDescription(offer))
+    .then(() => pc2.setRemoteDescription(pc1.localDescription))
+    .then(() => pc2.createAnswer())
+    .then(answer => pc2.setLocalDescription(answer))
+    .then(() => pc1.setRemoteDescription(pc2.localDescription));
+}
+
+function measure(udpBatching, megabytes) {
+  const { RTCPeerConnection, nonstandard } = require('..');
+  const { RTCPeerConnectionFactory } = nonstandard;
+
+  const factory = new RTCPeerConnectionFactory({ udpBatching, dataChannelsOnly: true });
+  const pc1 = new RTCPeerConnection({ factory });
+  const pc2 = new RTCPeerConnection({ factory });
+  const channel = pc1.createDataChannel('benchmark', { ordered: false });
+  channel.binaryType = 'arraybuffer';
+
+  const total = megabytes * 1024 * 1024;
+  const chunk = new ArrayBuffer(CHUNK_SIZE);
+
+  const received = new Promise(resolve => {
+    pc2.ondatachannel = ({ channel }) => {
+      let bytes = 0;
+      channel.onmessage = ({ data }) => {
+        bytes += data.byteLength;
+        if (bytes >= total) {
+          resolve();
+        }
+      };
+    };
+  });
+
+  const opened = new Promise(resolve => { channel.onopen = resolve; });
+
+  return connect(pc1, pc2).then(() => opened).then(() => {
+    const start = process.hrtime();
+    let sent = 0;
+
+    function send() {
+      while (sent < total && channel.bufferedAmount < HIGH_WATER_MARK) {
+        channel.send(chunk);
+        sent += CHUNK_SIZE;
+      }
+    }
+
+    channel.bufferedAmountLowThreshold = HIGH_WATER_MARK / 2;
+    channel.onbufferedamountlow = send;
+    send();
+
+    return received.then(() => {
+      const [seconds, nanoseconds] = process.hrtime(start);
+      pc1.close();
+      pc2.close();
+      return {
+        udpBatching,
+        megabytes,
+        seconds: seconds + nanoseconds / 1e9,
+        cpu: process.cpuUsage()
+      };
+    });
+  });
+}
+
+function child() {
+  const udpBatching = process.env.UDP_BATCHING === 'true';
+  measure(udpBatching, MEGABYTES).then(result => {
+    console.log(JSON.stringify(result));
+    process.exit(0);
+  }, error => {
+    console.error(error);
+    process.exit(1);
+  });
+}
+
+function parent() {
+  console.log('Sending ' + MEGABYTES + ' MB over an RTCDataChannel on loopback\n');
+  [false, true].forEach(udpBatching => {
+    const result = spawnSync(process.execPath, [__filename, String(MEGABYTES)], {
+      env: Object.assign({}, process.env, {
+        BENCHMARK_CHILD: 'true',
+        UDP_BATCHING: String(udpBatching)
+      }),
+      stdio: ['ignore', 'pipe', 'inherit']
+    });
+    if (result.status) {
+      throw new Error('Benchmark failed');
+    }
+    const lines = result.stdout.toString().trim().split('\n');
+    const { seconds, cpu } = JSON.parse(lines[lines.length - 1]);
+    console.log('udpBatching: ' + udpBatching);
+    console.log('  throughput: ' + (MEGABYTES / seconds).toFixed(1) + ' MB/s');
+    console.log('  CPU time: ' + ((cpu.user + cpu.system) / 1e6).toFixed(2) + ' s ('
+      + (cpu.system / 1e6).toFixed(2) + ' s system)\n');
+  });
+}
+
+if (process.env.BENCHMARK_CHILD) {
+  child();
+} else {
+  parent();
+}
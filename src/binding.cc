@@ -12,6 +12,7 @@
 #include "src/interfaces/legacy_rtc_stats_report.h"
 #include "src/interfaces/media_stream.h"
 #include "src/interfaces/media_stream_track.h"
+#include "src/interfaces/rtc_audio_mixer.h"
 #include "src/interfaces/rtc_audio_sink.h"
 #include "src/interfaces/rtc_audio_source.h"
 #include "src/interfaces/rtc_data_channel.h"
@@ -48,6 +49,7 @@ static Napi::Object Init(Napi::Env env, Napi::Object exports) {
   node_webrtc::MediaStream::Init(env, exports);
   node_webrtc::MediaStreamTrack::Init(env, exports);
   node_webrtc::PeerConnectionFactory::Init(env, exports);
+  node_webrtc::RTCAudioMixer::Init(env, exports);
   node_webrtc::RTCAudioSink::Init(env, exports);
   node_webrtc::RTCAudioSource::Init(env, exports);
   node_webrtc::RTCDataChannel::Init(env, exports);
@@ -9,20 +9,23 @@
 #include "src/enums/webrtc/rtcp_mux_policy.h"
 #include "src/enums/webrtc/sdp_semantics.h"
 #include "src/functional/curry.h"
+#include "src/interfaces/rtc_peer_connection/peer_connection_factory.h"
 
 namespace node_webrtc {
 
 static ExtendedRTCConfiguration CreateExtendedRTCConfiguration(
     const webrtc::PeerConnectionInterface::RTCConfiguration& configuration,
-    const UnsignedShortRange portRange) {
-  return ExtendedRTCConfiguration(configuration, portRange);
+    const UnsignedShortRange portRange,
+    const Maybe<PeerConnectionFactory*> factory) {
+  return ExtendedRTCConfiguration(configuration, portRange, factory);
 }
 
 FROM_NAPI_IMPL(ExtendedRTCConfiguration, value) {
   return From<Napi::Object>(value).FlatMap<ExtendedRTCConfiguration>([value](auto object) {
     return curry(CreateExtendedRTCConfiguration)
         % From<webrtc::PeerConnectionInterface::RTCConfiguration>(value)
-        * GetOptional<UnsignedShortRange>(object, "portRange", UnsignedShortRange());
+        * GetOptional<UnsignedShortRange>(object, "portRange", UnsignedShortRange())
+        * GetOptional<PeerConnectionFactory*>(object, "factory");
   });
 }
 
@@ -33,7 +36,8 @@ static Validation<Napi::Value> ExtendedRTCConfigurationToJavaScript(
     const Napi::Value rtcpMuxPolicy,
     const Napi::Value iceCandidatePoolSize,
     const Napi::Value portRange,
-    const Napi::Value sdpSemantics) {
+    const Napi::Value sdpSemantics,
+    const Napi::Value factory) {
   auto env = iceServers.Env();
   Napi::EscapableHandleScope scope(iceServers.Env());
   NODE_WEBRTC_CREATE_OBJECT_OR_RETURN(env, object)
@@ -44,6 +48,9 @@ static Validation<Napi::Value> ExtendedRTCConfigurationToJavaScript(
   NODE_WEBRTC_CONVERT_AND_SET_OR_RETURN(env, object, "iceCandidatePoolSize", iceCandidatePoolSize)
   NODE_WEBRTC_CONVERT_AND_SET_OR_RETURN(env, object, "portRange", portRange)
   NODE_WEBRTC_CONVERT_AND_SET_OR_RETURN(env, object, "sdpSemantics", sdpSemantics)
+  if (!factory.IsNull()) {
+    NODE_WEBRTC_CONVERT_AND_SET_OR_RETURN(env, object, "factory", factory)
+  }
   return Pure(scope.Escape(object));
 }
 
@@ -55,7 +62,8 @@ TO_NAPI_IMPL(ExtendedRTCConfiguration, pair) {
           * From<Napi::Value>(std::make_pair(pair.first, pair.second.configuration.rtcp_mux_policy))
           * From<Napi::Value>(std::make_pair(pair.first, pair.second.configuration.ice_candidate_pool_size))
           * From<Napi::Value>(std::make_pair(pair.first, pair.second.portRange))
-          * From<Napi::Value>(std::make_pair(pair.first, pair.second.configuration.sdp_semantics)));
+          * From<Napi::Value>(std::make_pair(pair.first, pair.second.configuration.sdp_semantics))
+          * From<Napi::Value>(std::make_pair(pair.first, pair.second.factory)));
 }
 
 }  // namespace node_webrtc
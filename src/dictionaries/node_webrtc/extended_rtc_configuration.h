@@ -4,9 +4,12 @@
 
 #include "src/converters/napi.h"
 #include "src/dictionaries/node_webrtc/unsigned_short_range.h"
+#include "src/functional/maybe.h"
 
 namespace node_webrtc {
 
+class PeerConnectionFactory;
+
 struct ExtendedRTCConfiguration {
   ExtendedRTCConfiguration():
     configuration(webrtc::PeerConnectionInterface::RTCConfiguration()),
@@ -18,8 +21,17 @@ struct ExtendedRTCConfiguration {
     configuration(configuration),
     portRange(portRange) {}
 
+  ExtendedRTCConfiguration(
+      const webrtc::PeerConnectionInterface::RTCConfiguration& configuration,
+      const UnsignedShortRange portRange,
+      const Maybe<PeerConnectionFactory*> factory):
+    configuration(configuration),
+    portRange(portRange),
+    factory(factory) {}
+
   webrtc::PeerConnectionInterface::RTCConfiguration configuration;
   UnsignedShortRange portRange;
+  Maybe<PeerConnectionFactory*> factory;
 };
 
 DECLARE_TO_AND_FROM_NAPI(ExtendedRTCConfiguration)
@@ -0,0 +1,25 @@
+#include "src/dictionaries/node_webrtc/legacy_stats.h"
+
+#include <node-addon-api/napi.h>
+
+#include "src/dictionaries/macros/napi.h"
+#include "src/functional/validation.h"
+
+namespace node_webrtc {
+
+TO_NAPI_IMPL(LegacyStats, pair) {
+  auto env = pair.first;
+  Napi::EscapableHandleScope scope(env);
+  auto& report = pair.second;
+  NODE_WEBRTC_CREATE_OBJECT_OR_RETURN(env, object)
+  for (auto const& stat : report.stats) {
+    NODE_WEBRTC_CONVERT_AND_SET_OR_RETURN(env, object, stat.first, stat.second)
+  }
+  // These are set last, so they win over any stat with the same name.
+  NODE_WEBRTC_CONVERT_AND_SET_OR_RETURN(env, object, "id", report.id)
+  NODE_WEBRTC_CONVERT_AND_SET_OR_RETURN(env, object, "type", report.type)
+  NODE_WEBRTC_CONVERT_AND_SET_OR_RETURN(env, object, "timestamp", report.timestamp)
+  return Pure(scope.Escape(object));
+}
+
+}  // namespace node_webrtc
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "src/converters/napi.h"
+
+namespace node_webrtc {
+
+// LegacyStats is a legacy stats report, flattened for conversion to a plain
+// object: one property per stat, plus "id", "type", and "timestamp", which
+// take precedence over stats of the same name. Unlike a LegacyStatsReport, it
+// needs no ObjectWrap, and its stats are looked up like any other property.
+struct LegacyStats {
+  std::string id;
+  std::string type;
+  double timestamp;
+  std::vector<std::pair<std::string, std::string>> stats;
+};
+
+DECLARE_TO_NAPI(LegacyStats)
+
+}  // namespace node_webrtc
@@ -0,0 +1,81 @@
+#include "src/dictionaries/node_webrtc/peer_connection_factory_options.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "src/functional/validation.h"
+
+namespace node_webrtc {
+
+#define PEER_CONNECTION_FACTORY_OPTIONS_FN CreatePeerConnectionFactoryOptions
+
+static Validation<PEER_CONNECTION_FACTORY_OPTIONS> PEER_CONNECTION_FACTORY_OPTIONS_FN(
+    const AudioCapturerType audioCapturer,
+    const AudioRendererType audioRenderer,
+    const Maybe<std::string>& audioRendererFile,
+    const double audioSpeed,
+    const std::string& threadNamePrefix,
+    const Maybe<std::vector<uint32_t>>& networkThreadAffinity,
+    const Maybe<std::vector<uint32_t>>& workerThreadAffinity,
+    const Maybe<std::vector<uint32_t>>& signalingThreadAffinity,
+    const uint16_t taskQueueThreads,
+    const bool dataChannelsOnly,
+    const bool udpBatching,
+    const SocketServerType networkSocketServer,
+    const Maybe<uint16_t>& sharedUdpPort,
+    const bool cacheNetworks,
+    const uint32_t networkRefreshInterval,
+    const Maybe<std::vector<std::string>>& networkInterfaceAllowlist,
+    const Maybe<std::vector<std::string>>& networkInterfaceDenylist,
+    const uint16_t iceCandidatePoolSize,
+    const uint32_t iceCandidatePoolTtl) {
+  if (audioRenderer == kWavFileAudioRenderer && audioRendererFile.IsNothing()) {
+    return Validation<PEER_CONNECTION_FACTORY_OPTIONS>::Invalid(
+            "Expected an .audioRendererFile when .audioRenderer is \"wav\"");
+  }
+  if (!(audioSpeed > 0)) {
+    return Validation<PEER_CONNECTION_FACTORY_OPTIONS>::Invalid(
+            "Expected an .audioSpeed greater than 0, not " + std::to_string(audioSpeed));
+  }
+  if (!networkRefreshInterval) {
+    return Validation<PEER_CONNECTION_FACTORY_OPTIONS>::Invalid(
+            "Expected a .networkRefreshInterval greater than 0");
+  }
+  if (!iceCandidatePoolTtl || iceCandidatePoolTtl > INT32_MAX) {
+    return Validation<PEER_CONNECTION_FACTORY_OPTIONS>::Invalid(
+            "Expected an .iceCandidatePoolTtl greater than 0, not " + std::to_string(iceCandidatePoolTtl));
+  }
+  if (iceCandidatePoolSize && sharedUdpPort.IsJust()) {
+    // Pooled sessions would bind sockets of their own, off the shared port.
+    return Validation<PEER_CONNECTION_FACTORY_OPTIONS>::Invalid(
+            "Expected either an .iceCandidatePoolSize or a .sharedUdpPort, not both");
+  }
+  PEER_CONNECTION_FACTORY_OPTIONS options;
+  options.audioCapturer = audioCapturer;
+  options.audioRenderer = audioRenderer;
+  options.audioRendererFile = audioRendererFile;
+  options.audioSpeed = audioSpeed;
+  options.threadNamePrefix = threadNamePrefix;
+  options.networkThreadAffinity = networkThreadAffinity;
+  options.workerThreadAffinity = workerThreadAffinity;
+  options.signalingThreadAffinity = signalingThreadAffinity;
+  options.taskQueueThreads = taskQueueThreads;
+  options.dataChannelsOnly = dataChannelsOnly;
+  options.udpBatching = udpBatching;
+  options.networkSocketServer = networkSocketServer;
+  options.sharedUdpPort = sharedUdpPort;
+  options.cacheNetworks = cacheNetworks;
+  options.networkRefreshInterval = networkRefreshInterval;
+  options.networkInterfaceAllowlist = networkInterfaceAllowlist;
+  options.networkInterfaceDenylist = networkInterfaceDenylist;
+  options.iceCandidatePoolSize = iceCandidatePoolSize;
+  options.iceCandidatePoolTtl = iceCandidatePoolTtl;
+  return Pure(options);
+}
+
+}  // namespace node_webrtc
+
+#define DICT(X) PEER_CONNECTION_FACTORY_OPTIONS ## X
+#include "src/dictionaries/macros/impls.h"
+#undef DICT
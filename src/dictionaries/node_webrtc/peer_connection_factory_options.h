@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "src/enums/node_webrtc/audio_capturer_type.h"
+#include "src/enums/node_webrtc/audio_renderer_type.h"
+#include "src/enums/node_webrtc/socket_server_type.h"
+#include "src/functional/maybe.h"
+
+// IWYU pragma: no_include "src/dictionaries/macros/impls.h"
+
+namespace node_webrtc {
+
+struct PeerConnectionFactoryOptions {
+  AudioCapturerType audioCapturer = kZeroAudioCapturer;
+  AudioRendererType audioRenderer = kDiscardAudioRenderer;
+  Maybe<std::string> audioRendererFile;
+  double audioSpeed = 1;
+  std::string threadNamePrefix = "PeerConnectionFactory";
+  Maybe<std::vector<uint32_t>> networkThreadAffinity;
+  Maybe<std::vector<uint32_t>> workerThreadAffinity;
+  Maybe<std::vector<uint32_t>> signalingThreadAffinity;
+  uint16_t taskQueueThreads = 0;
+  bool dataChannelsOnly = false;
+  bool udpBatching = false;
+  SocketServerType networkSocketServer = kPhysicalSocketServer;
+  Maybe<uint16_t> sharedUdpPort;
+  bool cacheNetworks = false;
+  uint32_t networkRefreshInterval = 2000;
+  Maybe<std::vector<std::string>> networkInterfaceAllowlist;
+  Maybe<std::vector<std::string>> networkInterfaceDenylist;
+  uint16_t iceCandidatePoolSize = 0;
+  uint32_t iceCandidatePoolTtl = 60000;
+};
+
+}  // namespace node_webrtc
+
+#define PEER_CONNECTION_FACTORY_OPTIONS PeerConnectionFactoryOptions
+#define PEER_CONNECTION_FACTORY_OPTIONS_LIST \
+  DICT_DEFAULT(AudioCapturerType, audioCapturer, "audioCapturer", kZeroAudioCapturer) \
+  DICT_DEFAULT(AudioRendererType, audioRenderer, "audioRenderer", kDiscardAudioRenderer) \
+  DICT_OPTIONAL(std::string, audioRendererFile, "audioRendererFile") \
+  DICT_DEFAULT(double, audioSpeed, "audioSpeed", 1) \
+  DICT_DEFAULT(std::string, threadNamePrefix, "threadNamePrefix", "PeerConnectionFactory") \
+  DICT_OPTIONAL(std::vector<uint32_t>, networkThreadAffinity, "networkThreadAffinity") \
+  DICT_OPTIONAL(std::vector<uint32_t>, workerThreadAffinity, "workerThreadAffinity") \
+  DICT_OPTIONAL(std::vector<uint32_t>, signalingThreadAffinity, "signalingThreadAffinity") \
+  DICT_DEFAULT(uint16_t, taskQueueThreads, "taskQueueThreads", 0) \
+  DICT_DEFAULT(bool, dataChannelsOnly, "dataChannelsOnly", false) \
+  DICT_DEFAULT(bool, udpBatching, "udpBatching", false) \
+  DICT_DEFAULT(SocketServerType, networkSocketServer, "networkSocketServer", kPhysicalSocketServer) \
+  DICT_OPTIONAL(uint16_t, sharedUdpPort, "sharedUdpPort") \
+  DICT_DEFAULT(bool, cacheNetworks, "cacheNetworks", false) \
+  DICT_DEFAULT(uint32_t, networkRefreshInterval, "networkRefreshInterval", 2000) \
+  DICT_OPTIONAL(std::vector<std::string>, networkInterfaceAllowlist, "networkInterfaceAllowlist") \
+  DICT_OPTIONAL(std::vector<std::string>, networkInterfaceDenylist, "networkInterfaceDenylist") \
+  DICT_DEFAULT(uint16_t, iceCandidatePoolSize, "iceCandidatePoolSize", 0) \
+  DICT_DEFAULT(uint32_t, iceCandidatePoolTtl, "iceCandidatePoolTtl", 60000)
+
+#define DICT(X) PEER_CONNECTION_FACTORY_OPTIONS ## X
+#include "src/dictionaries/macros/decls.h"
+#undef DICT
@@ -1,15 +1,19 @@
 #include "src/dictionaries/node_webrtc/rtc_answer_options.h"
 
+#include <vector>
+
 #include "src/functional/validation.h"
 
 namespace node_webrtc {
 
 #define RTC_ANSWER_OPTIONS_FN CreateRTCAnswerOptions
 
-static Validation<RTC_ANSWER_OPTIONS> RTC_ANSWER_OPTIONS_FN(const bool voiceActivityDetection) {
+static Validation<RTC_ANSWER_OPTIONS> RTC_ANSWER_OPTIONS_FN(
+    const bool voiceActivityDetection,
+    const std::vector<RTCSdpEdit> sdpEdits) {
   webrtc::PeerConnectionInterface::RTCOfferAnswerOptions options;
   options.voice_activity_detection = voiceActivityDetection;
-  return Pure(RTC_ANSWER_OPTIONS(options));
+  return Pure(RTC_ANSWER_OPTIONS(options, sdpEdits));
 }
 
 }  // namespace node_webrtc
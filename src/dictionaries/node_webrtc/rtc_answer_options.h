@@ -1,7 +1,12 @@
 #pragma once
 
+#include <utility>
+#include <vector>
+
 #include <webrtc/api/peer_connection_interface.h>
 
+#include "src/dictionaries/node_webrtc/rtc_sdp_edit.h"
+
 // IWYU pragma: no_include "src/dictionaries/macros/impls.h"
 
 namespace node_webrtc {
@@ -9,14 +14,19 @@ namespace node_webrtc {
 struct RTCAnswerOptions {
   RTCAnswerOptions(): options(webrtc::PeerConnectionInterface::RTCOfferAnswerOptions()) {}
   explicit RTCAnswerOptions(const webrtc::PeerConnectionInterface::RTCOfferAnswerOptions options): options(options) {}
+  RTCAnswerOptions(const webrtc::PeerConnectionInterface::RTCOfferAnswerOptions options, std::vector<RTCSdpEdit> sdpEdits)
+    : options(options)
+    , sdpEdits(std::move(sdpEdits)) {}
   const webrtc::PeerConnectionInterface::RTCOfferAnswerOptions options;
+  std::vector<RTCSdpEdit> sdpEdits;
 };
 
 }  // namespace node_webrtc
 
 #define RTC_ANSWER_OPTIONS RTCAnswerOptions
 #define RTC_ANSWER_OPTIONS_LIST \
-  DICT_DEFAULT(bool, voiceActivityDetection, "voiceActivityDetection", true)
+  DICT_DEFAULT(bool, voiceActivityDetection, "voiceActivityDetection", true) \
+  DICT_DEFAULT(std::vector<RTCSdpEdit>, sdpEdits, "sdpEdits", std::vector<RTCSdpEdit>())
 
 #define DICT(X) RTC_ANSWER_OPTIONS ## X
 #include "src/dictionaries/macros/decls.h"
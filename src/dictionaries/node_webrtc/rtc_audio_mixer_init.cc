@@ -0,0 +1,29 @@
+#include "src/dictionaries/node_webrtc/rtc_audio_mixer_init.h"
+
+#include <string>
+
+#include "src/functional/validation.h"
+
+namespace node_webrtc {
+
+#define RTC_AUDIO_MIXER_INIT_FN CreateRTCAudioMixerInit
+
+static Validation<RTC_AUDIO_MIXER_INIT> RTC_AUDIO_MIXER_INIT_FN(
+    const uint16_t sampleRate,
+    const uint8_t channelCount) {
+  if (sampleRate != 8000 && sampleRate != 16000 && sampleRate != 32000 && sampleRate != 48000) {
+    auto error = "Expected a .sampleRate of 8000, 16000, 32000, or 48000, not " + std::to_string(sampleRate);
+    return Validation<RTC_AUDIO_MIXER_INIT>::Invalid(error);
+  }
+  if (channelCount != 1 && channelCount != 2) {
+    auto error = "Expected a .channelCount of 1 or 2, not " + std::to_string(channelCount);
+    return Validation<RTC_AUDIO_MIXER_INIT>::Invalid(error);
+  }
+  return Pure<RTC_AUDIO_MIXER_INIT>({sampleRate, channelCount});
+}
+
+}  // namespace node_webrtc
+
+#define DICT(X) RTC_AUDIO_MIXER_INIT ## X
+#include "src/dictionaries/macros/impls.h"
+#undef DICT
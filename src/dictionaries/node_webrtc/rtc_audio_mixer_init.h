@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstdint>
+
+// IWYU pragma: no_forward_declare node_webrtc::RTCAudioMixerInit
+// IWYU pragma: no_include "src/dictionaries/macros/impls.h"
+
+#define RTC_AUDIO_MIXER_INIT RTCAudioMixerInit
+#define RTC_AUDIO_MIXER_INIT_LIST \
+  DICT_DEFAULT(uint16_t, sampleRate, "sampleRate", 48000) \
+  DICT_DEFAULT(uint8_t, channelCount, "channelCount", 1)
+
+#define DICT(X) RTC_AUDIO_MIXER_INIT ## X
+#include "src/dictionaries/macros/def.h"
+#include "src/dictionaries/macros/decls.h"
+#undef DICT
@@ -0,0 +1,31 @@
+#include "src/dictionaries/node_webrtc/rtc_audio_sink_init.h"
+
+#include <string>
+
+#include "src/functional/validation.h"
+
+namespace node_webrtc {
+
+#define RTC_AUDIO_SINK_INIT_FN CreateRTCAudioSinkInit
+
+static Validation<RTC_AUDIO_SINK_INIT> RTC_AUDIO_SINK_INIT_FN(
+    const bool vad,
+    const uint8_t vadAggressiveness,
+    const uint16_t vadHangover,
+    const bool suppressSilence,
+    const uint16_t levelInterval) {
+  if (vadAggressiveness > 3) {
+    auto error = "Expected a .vadAggressiveness between 0 and 3, not " + std::to_string(vadAggressiveness);
+    return Validation<RTC_AUDIO_SINK_INIT>::Invalid(error);
+  }
+  if (suppressSilence && !vad) {
+    return Validation<RTC_AUDIO_SINK_INIT>::Invalid(".suppressSilence requires .vad to be true");
+  }
+  return Pure<RTC_AUDIO_SINK_INIT>({vad, vadAggressiveness, vadHangover, suppressSilence, levelInterval});
+}
+
+}  // namespace node_webrtc
+
+#define DICT(X) RTC_AUDIO_SINK_INIT ## X
+#include "src/dictionaries/macros/impls.h"
+#undef DICT
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstdint>
+
+// IWYU pragma: no_include "src/dictionaries/macros/impls.h"
+
+namespace node_webrtc {
+
+struct RTCAudioSinkInit {
+  bool vad = false;
+  uint8_t vadAggressiveness = 2;
+  uint16_t vadHangover = 200;
+  bool suppressSilence = false;
+  uint16_t levelInterval = 0;
+};
+
+}  // namespace node_webrtc
+
+#define RTC_AUDIO_SINK_INIT RTCAudioSinkInit
+#define RTC_AUDIO_SINK_INIT_LIST \
+  DICT_DEFAULT(bool, vad, "vad", false) \
+  DICT_DEFAULT(uint8_t, vadAggressiveness, "vadAggressiveness", 2) \
+  DICT_DEFAULT(uint16_t, vadHangover, "vadHangover", 200) \
+  DICT_DEFAULT(bool, suppressSilence, "suppressSilence", false) \
+  DICT_DEFAULT(uint16_t, levelInterval, "levelInterval", 0)
+
+#define DICT(X) RTC_AUDIO_SINK_INIT ## X
+#include "src/dictionaries/macros/decls.h"
+#undef DICT
@@ -1,5 +1,7 @@
 #include "src/dictionaries/node_webrtc/rtc_offer_options.h"
 
+#include <vector>
+
 #include "src/functional/maybe.h"
 #include "src/functional/validation.h"
 
@@ -11,7 +13,8 @@ static Validation<RTC_OFFER_OPTIONS> RTC_OFFER_OPTIONS_FN(
     const bool voiceActivityDetection,
     const bool iceRestart,
     const Maybe<bool> offerToReceiveAudio,
-    const Maybe<bool> offerToReceiveVideo) {
+    const Maybe<bool> offerToReceiveVideo,
+    const std::vector<RTCSdpEdit> sdpEdits) {
   webrtc::PeerConnectionInterface::RTCOfferAnswerOptions options;
   options.ice_restart = iceRestart;
   options.voice_activity_detection = voiceActivityDetection;
@@ -25,7 +28,7 @@ static Validation<RTC_OFFER_OPTIONS> RTC_OFFER_OPTIONS_FN(
         ? webrtc::PeerConnectionInterface::RTCOfferAnswerOptions::kOfferToReceiveMediaTrue
         : 0;
   }).FromMaybe(webrtc::PeerConnectionInterface::RTCOfferAnswerOptions::kUndefined);
-  return Pure(RTC_OFFER_OPTIONS(options));
+  return Pure(RTC_OFFER_OPTIONS(options, sdpEdits));
 }
 
 }  // namespace node_webrtc
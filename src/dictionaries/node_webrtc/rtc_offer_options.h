@@ -1,7 +1,12 @@
 #pragma once
 
+#include <utility>
+#include <vector>
+
 #include <webrtc/api/peer_connection_interface.h>
 
+#include "src/dictionaries/node_webrtc/rtc_sdp_edit.h"
+
 // IWYU pragma: no_include "src/dictionaries/macros/impls.h"
 
 namespace node_webrtc {
@@ -9,7 +14,11 @@ namespace node_webrtc {
 struct RTCOfferOptions {
   RTCOfferOptions(): options(webrtc::PeerConnectionInterface::RTCOfferAnswerOptions()) {}
   explicit RTCOfferOptions(const webrtc::PeerConnectionInterface::RTCOfferAnswerOptions options): options(options) {}
+  RTCOfferOptions(const webrtc::PeerConnectionInterface::RTCOfferAnswerOptions options, std::vector<RTCSdpEdit> sdpEdits)
+    : options(options)
+    , sdpEdits(std::move(sdpEdits)) {}
   const webrtc::PeerConnectionInterface::RTCOfferAnswerOptions options;
+  std::vector<RTCSdpEdit> sdpEdits;
 };
 
 }  // namespace node_webrtc
@@ -19,7 +28,8 @@ struct RTCOfferOptions {
   DICT_DEFAULT(bool, voiceActivityDetection, "voiceActivityDetection", true) \
   DICT_DEFAULT(bool, iceRestart, "iceRestart", false) \
   DICT_OPTIONAL(bool, offerToReceiveAudio, "offerToReceiveAudio") \
-  DICT_OPTIONAL(bool, offerToReceiveVideo, "offerToReceiveVideo")
+  DICT_OPTIONAL(bool, offerToReceiveVideo, "offerToReceiveVideo") \
+  DICT_DEFAULT(std::vector<RTCSdpEdit>, sdpEdits, "sdpEdits", std::vector<RTCSdpEdit>())
 
 #define DICT(X) RTC_OFFER_OPTIONS ## X
 #include "src/dictionaries/macros/decls.h"
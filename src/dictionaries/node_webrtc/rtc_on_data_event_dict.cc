@@ -1,5 +1,7 @@
 #include "src/dictionaries/node_webrtc/rtc_on_data_event_dict.h"
 
+#include <memory>
+
 #include <node-addon-api/napi.h>
 
 #include "src/converters/object.h"
@@ -37,15 +39,12 @@ static Validation<RTC_ON_DATA_EVENT_DICT> CreateRTCOnDataEventDict(
     return Validation<RTC_ON_DATA_EVENT_DICT>::Invalid(error);
   }
 
-  std::unique_ptr<uint8_t[]> samplesCopy(new uint8_t[actualByteLength]);
-  if (!samplesCopy) {
-    auto error = "Failed to copy samples";
-    return Validation<RTC_ON_DATA_EVENT_DICT>::Invalid(error);
-  }
-  memcpy(samplesCopy.get(), samples.Data(), actualByteLength);
+  // The samples are not copied: the RTCOnDataEventDict borrows the
+  // ArrayBuffer's contents and must not outlive the call that converted it.
+  std::shared_ptr<uint8_t> borrowedSamples(static_cast<uint8_t*>(samples.Data()), [](uint8_t*) {});
 
   RTC_ON_DATA_EVENT_DICT dict = {
-    samplesCopy.release(),
+    borrowedSamples,
     bitsPerSample,
     sampleRate,
     channelCount,
@@ -71,7 +70,6 @@ TO_NAPI_IMPL(RTC_ON_DATA_EVENT_DICT, pair) {
   Napi::EscapableHandleScope scope(env);
 
   auto dict = pair.second;
-  std::unique_ptr<uint8_t> samples(dict.samples);
 
   if (dict.numberOfFrames.IsNothing()) {
     return Validation<Napi::Value>::Invalid("numberOfFrames not provided");
@@ -80,8 +78,9 @@ TO_NAPI_IMPL(RTC_ON_DATA_EVENT_DICT, pair) {
 
   auto length = dict.channelCount * numberOfFrames;
   auto byteLength = length * dict.bitsPerSample / 8;
-  auto maybeArrayBuffer = Napi::ArrayBuffer::New(env, samples.release(), byteLength, [](Napi::Env, void* samples) {
-    delete static_cast<uint8_t*>(samples);
+  auto samples = dict.samples;
+  auto maybeArrayBuffer = Napi::ArrayBuffer::New(env, samples.get(), byteLength, [samples](Napi::Env, void*) {
+    // Do nothing; releasing the captured std::shared_ptr frees the samples.
   });
   if (maybeArrayBuffer.Env().IsExceptionPending()) {
     return Validation<Napi::Value>::Invalid(maybeArrayBuffer.Env().GetAndClearPendingException().Message());
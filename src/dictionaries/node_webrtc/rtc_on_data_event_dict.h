@@ -1,12 +1,13 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
 
 // IWYU pragma: no_forward_declare node_webrtc::RTCOnDataEventDict
 
 #define RTC_ON_DATA_EVENT_DICT RTCOnDataEventDict
 #define RTC_ON_DATA_EVENT_DICT_LIST \
-  DICT_REQUIRED(uint8_t*, samples, "samples") \
+  DICT_REQUIRED(std::shared_ptr<uint8_t>, samples, "samples") \
   DICT_DEFAULT(uint8_t, bitsPerSample, "bitsPerSample", 16) \
   DICT_REQUIRED(uint16_t, sampleRate, "sampleRate") \
   DICT_DEFAULT(uint8_t, channelCount, "channelCount", 1) \
@@ -0,0 +1,74 @@
+#include "src/dictionaries/node_webrtc/rtc_sdp_edit.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "src/enums/webrtc/media_type.h"
+#include "src/functional/maybe.h"
+#include "src/functional/validation.h"
+
+namespace node_webrtc {
+
+namespace {
+
+std::string Trim(const std::string& string) {
+  auto first = string.find_first_not_of(' ');
+  if (first == std::string::npos) {
+    return "";
+  }
+  return string.substr(first, string.find_last_not_of(' ') - first + 1);
+}
+
+}  // namespace
+
+#define RTC_SDP_EDIT_FN CreateRTCSdpEdit
+
+static Validation<RTC_SDP_EDIT> RTC_SDP_EDIT_FN(
+    const Maybe<std::string> mid,
+    const Maybe<cricket::MediaType> kind,
+    const std::vector<std::string> codecs,
+    const Maybe<uint32_t> bandwidth,
+    const Maybe<std::string> fmtp,
+    const bool remove) {
+  if (bandwidth.IsJust() && bandwidth.UnsafeFromJust() > INT32_MAX / 1000) {
+    return Validation<RTC_SDP_EDIT>::Invalid(
+            "Expected a .bandwidth of at most " + std::to_string(INT32_MAX / 1000) + " kbps, not "
+            + std::to_string(bandwidth.UnsafeFromJust()));
+  }
+
+  RTC_SDP_EDIT edit;
+  edit.mid = mid;
+  edit.kind = kind;
+  edit.codecs = codecs;
+  edit.bandwidth = bandwidth;
+  edit.remove = remove;
+
+  // Parameters are separated by ";", like in "a=fmtp".
+  auto parameters = fmtp.FromMaybe("");
+  size_t start = 0;
+  while (start < parameters.size()) {
+    auto end = parameters.find(';', start);
+    if (end == std::string::npos) {
+      end = parameters.size();
+    }
+    auto parameter = Trim(parameters.substr(start, end - start));
+    start = end + 1;
+    if (parameter.empty()) {
+      continue;
+    }
+    auto equals = parameter.find('=');
+    if (equals == 0 || equals == std::string::npos) {
+      return Validation<RTC_SDP_EDIT>::Invalid("Expected .fmtp parameters of the form \"name=value\", not \"" + parameter + "\"");
+    }
+    edit.fmtp.emplace_back(Trim(parameter.substr(0, equals)), Trim(parameter.substr(equals + 1)));
+  }
+
+  return Pure(edit);
+}
+
+}  // namespace node_webrtc
+
+#define DICT(X) RTC_SDP_EDIT ## X
+#include "src/dictionaries/macros/impls.h"
+#undef DICT
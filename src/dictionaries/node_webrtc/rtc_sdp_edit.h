@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <webrtc/api/media_types.h>
+
+#include "src/functional/maybe.h"
+
+// IWYU pragma: no_include "src/dictionaries/macros/impls.h"
+
+namespace node_webrtc {
+
+// RTCSdpEdit describes an edit to every media section of a session
+// description with the given mid and kind, applied natively by createOffer
+// and createAnswer (see ApplySdpEdits).
+struct RTCSdpEdit {
+  Maybe<std::string> mid;
+  Maybe<cricket::MediaType> kind;
+  // Codec names to move to the front, in order.
+  std::vector<std::string> codecs;
+  // In kilobits per second, for "b=AS".
+  Maybe<uint32_t> bandwidth;
+  // Parameters to set on the listed codecs, or on every codec if none are.
+  std::vector<std::pair<std::string, std::string>> fmtp;
+  bool remove = false;
+};
+
+}  // namespace node_webrtc
+
+#define RTC_SDP_EDIT RTCSdpEdit
+#define RTC_SDP_EDIT_LIST \
+  DICT_OPTIONAL(std::string, mid, "mid") \
+  DICT_OPTIONAL(cricket::MediaType, kind, "kind") \
+  DICT_DEFAULT(std::vector<std::string>, codecs, "codecs", std::vector<std::string>()) \
+  DICT_OPTIONAL(uint32_t, bandwidth, "bandwidth") \
+  DICT_OPTIONAL(std::string, fmtp, "fmtp") \
+  DICT_DEFAULT(bool, remove, "remove", false)
+
+#define DICT(X) RTC_SDP_EDIT ## X
+#include "src/dictionaries/macros/decls.h"
+#undef DICT
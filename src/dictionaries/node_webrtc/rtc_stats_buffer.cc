@@ -0,0 +1,130 @@
+#include "src/dictionaries/node_webrtc/rtc_stats_buffer.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+
+#include <node-addon-api/napi.h>
+#include <webrtc/api/stats/rtc_stats.h>
+#include <webrtc/api/stats/rtc_stats_report.h>
+
+#include "src/dictionaries/macros/napi.h"
+#include "src/dictionaries/node_webrtc/rtc_stats_filter.h"
+#include "src/dictionaries/webrtc/rtc_stats_member_interface.h"
+#include "src/functional/validation.h"
+
+namespace node_webrtc {
+
+RTCStatsBuffer RTCStatsBuffer::Create(const webrtc::RTCStatsReport& report, const RTCStatsFilter* filter) {
+  auto buffer = Create(std::vector<const webrtc::RTCStatsReport*> {&report}, filter);
+  buffer.connections = MakeNothing<std::vector<uint32_t>>();
+  return buffer;
+}
+
+RTCStatsBuffer RTCStatsBuffer::Create(const std::vector<const webrtc::RTCStatsReport*>& reports, const RTCStatsFilter* filter) {
+  RTCStatsBuffer buffer;
+  buffer.members.emplace_back("timestamp");
+  std::unordered_map<std::string, size_t> columns;
+  columns.emplace("timestamp", 0);
+
+  auto fixedColumns = filter && !filter->memberNames.empty();
+  if (fixedColumns) {
+    for (auto& name : filter->memberNames) {
+      if (columns.emplace(name, buffer.members.size()).second) {
+        buffer.members.emplace_back(name);
+      }
+    }
+  }
+
+  // The first pass selects rows and, unless they are fixed, assigns every
+  // defined numeric member a column, in the order they are first seen; the
+  // second fills in the rows.
+  std::vector<const webrtc::RTCStats*> rows;
+  std::vector<uint32_t> connections;
+  for (uint32_t i = 0; i < reports.size(); i++) {
+    if (!reports[i]) {
+      continue;
+    }
+    for (const webrtc::RTCStats& stats : *reports[i]) {
+      if (filter && !filter->HasType(stats.type())) {
+        continue;
+      }
+      rows.push_back(&stats);
+      connections.push_back(i);
+      buffer.ids.emplace_back(stats.id());
+      buffer.types.emplace_back(stats.type());
+      if (fixedColumns) {
+        continue;
+      }
+      for (const webrtc::RTCStatsMemberInterface* member : stats.Members()) {
+        double number;
+        if (member->is_defined() && GetNumber(*member, &number)
+            && columns.emplace(member->name(), buffer.members.size()).second) {
+          buffer.members.emplace_back(member->name());
+        }
+      }
+    }
+  }
+  buffer.connections = MakeJust(std::move(connections));
+
+  auto stride = buffer.members.size();
+  buffer.values.assign(rows.size() * stride, std::numeric_limits<double>::quiet_NaN());
+  auto row = buffer.values.begin();
+  for (auto stats : rows) {
+    row[0] = stats->timestamp_us() / 1000.0;
+    for (const webrtc::RTCStatsMemberInterface* member : stats->Members()) {
+      double number;
+      if (!member->is_defined() || !GetNumber(*member, &number)) {
+        continue;
+      }
+      auto column = columns.find(member->name());
+      if (column != columns.end() && column->second) {
+        row[column->second] = number;
+      }
+    }
+    row += stride;
+  }
+
+  return buffer;
+}
+
+TO_NAPI_IMPL(RTCStatsBuffer, pair) {
+  auto env = pair.first;
+  Napi::EscapableHandleScope scope(env);
+  auto& buffer = pair.second;
+
+  auto byteLength = buffer.values.size() * sizeof(double);
+  auto maybeArrayBuffer = Napi::ArrayBuffer::New(env, byteLength);
+  if (maybeArrayBuffer.Env().IsExceptionPending()) {
+    return Validation<Napi::Value>::Invalid(maybeArrayBuffer.Env().GetAndClearPendingException().Message());
+  }
+  if (byteLength) {
+    memcpy(maybeArrayBuffer.Data(), buffer.values.data(), byteLength);
+  }
+  auto maybeValues = Napi::Float64Array::New(env, buffer.values.size(), maybeArrayBuffer, 0);
+  if (maybeValues.Env().IsExceptionPending()) {
+    return Validation<Napi::Value>::Invalid(maybeValues.Env().GetAndClearPendingException().Message());
+  }
+
+  NODE_WEBRTC_CREATE_OBJECT_OR_RETURN(env, object)
+  NODE_WEBRTC_CONVERT_AND_SET_OR_RETURN(env, object, "ids", buffer.ids)
+  NODE_WEBRTC_CONVERT_AND_SET_OR_RETURN(env, object, "types", buffer.types)
+  NODE_WEBRTC_CONVERT_AND_SET_OR_RETURN(env, object, "members", buffer.members)
+  NODE_WEBRTC_CONVERT_AND_SET_OR_RETURN(env, object, "values", static_cast<Napi::Value>(maybeValues))
+
+  if (buffer.connections.IsJust()) {
+    auto connections = buffer.connections.UnsafeFromJust();
+    auto maybeConnections = Napi::Uint32Array::New(env, connections.size());
+    if (maybeConnections.Env().IsExceptionPending()) {
+      return Validation<Napi::Value>::Invalid(maybeConnections.Env().GetAndClearPendingException().Message());
+    }
+    std::copy(connections.begin(), connections.end(), maybeConnections.Data());
+    NODE_WEBRTC_CONVERT_AND_SET_OR_RETURN(env, object, "connections", static_cast<Napi::Value>(maybeConnections))
+  }
+  return Pure(scope.Escape(object));
+}
+
+}  // namespace node_webrtc
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "src/converters/napi.h"
+#include "src/functional/maybe.h"
+
+namespace webrtc { class RTCStatsReport; }
+
+namespace node_webrtc {
+
+struct RTCStatsFilter;
+
+// RTCStatsBuffer is a columnar snapshot of an RTCStatsReport's numeric
+// members. Row i describes the stats object with ids[i] and types[i]; column j
+// holds the member named members[j]. values is row-major, so that the value of
+// members[j] for ids[i] is values[i * members.size() + j], or NaN if the
+// stats object does not define it. The first column is always "timestamp", in
+// milliseconds.
+struct RTCStatsBuffer {
+  std::vector<std::string> ids;
+  std::vector<std::string> types;
+  std::vector<std::string> members;
+  std::vector<double> values;
+
+  // When the rows come from several reports, the index of each row's report.
+  Maybe<std::vector<uint32_t>> connections;
+
+  // If |filter| selects members, the columns are those members, in order, even
+  // if no stats object defines them; otherwise, they are every numeric member
+  // defined by some stats object.
+  static RTCStatsBuffer Create(const webrtc::RTCStatsReport& report, const RTCStatsFilter* filter = nullptr);
+
+  // Like the above, but with the rows of every report in |reports|, in order,
+  // and |connections|. Null reports contribute no rows.
+  static RTCStatsBuffer Create(const std::vector<const webrtc::RTCStatsReport*>& reports, const RTCStatsFilter* filter = nullptr);
+};
+
+DECLARE_TO_NAPI(RTCStatsBuffer)
+
+}  // namespace node_webrtc
@@ -0,0 +1,22 @@
+#include "src/dictionaries/node_webrtc/rtc_stats_filter.h"
+
+#include "src/functional/maybe.h"
+#include "src/functional/validation.h"
+
+namespace node_webrtc {
+
+#define RTC_STATS_FILTER_FN CreateRTCStatsFilter
+
+static Validation<RTC_STATS_FILTER> RTC_STATS_FILTER_FN(
+    const Maybe<std::vector<std::string>> types,
+    const Maybe<std::vector<std::string>> members) {
+  return Pure(RTC_STATS_FILTER(
+          types.FromMaybe(std::vector<std::string>()),
+          members.FromMaybe(std::vector<std::string>())));
+}
+
+}  // namespace node_webrtc
+
+#define DICT(X) RTC_STATS_FILTER ## X
+#include "src/dictionaries/macros/impls.h"
+#undef DICT
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+// IWYU pragma: no_include "src/dictionaries/macros/impls.h"
+
+namespace node_webrtc {
+
+// RTCStatsFilter selects the stats objects whose type is one of |types|, and
+// their members named one of |members|, from an RTCStatsReport. An empty list
+// selects everything. A stats object's id, timestamp, and type are always
+// selected.
+struct RTCStatsFilter {
+  RTCStatsFilter() = default;
+  RTCStatsFilter(const std::vector<std::string>& types, const std::vector<std::string>& members)
+    : memberNames(members)
+    , types(types.begin(), types.end())
+    , members(members.begin(), members.end()) {}
+
+  bool HasType(const std::string& type) const {
+    return types.empty() || types.count(type);
+  }
+
+  bool HasMember(const std::string& member) const {
+    return members.empty() || members.count(member);
+  }
+
+  // The selected members, in the order they were given.
+  std::vector<std::string> memberNames;
+  std::unordered_set<std::string> types;
+  std::unordered_set<std::string> members;
+};
+
+}  // namespace node_webrtc
+
+#define RTC_STATS_FILTER RTCStatsFilter
+#define RTC_STATS_FILTER_LIST \
+  DICT_OPTIONAL(std::vector<std::string>, types, "types") \
+  DICT_OPTIONAL(std::vector<std::string>, members, "members")
+
+#define DICT(X) RTC_STATS_FILTER ## X
+#include "src/dictionaries/macros/decls.h"
+#undef DICT
@@ -0,0 +1,34 @@
+#include "src/dictionaries/node_webrtc/rtc_stats_subscription_options.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "src/functional/maybe.h"
+#include "src/functional/validation.h"
+
+namespace node_webrtc {
+
+#define RTC_STATS_SUBSCRIPTION_OPTIONS_FN CreateRTCStatsSubscriptionOptions
+
+static Validation<RTC_STATS_SUBSCRIPTION_OPTIONS> RTC_STATS_SUBSCRIPTION_OPTIONS_FN(
+    const uint32_t intervalMs,
+    const Maybe<std::vector<std::string>> types,
+    const Maybe<std::vector<std::string>> members) {
+  if (!intervalMs || intervalMs > INT32_MAX) {
+    return Validation<RTC_STATS_SUBSCRIPTION_OPTIONS>::Invalid(
+            "Expected an .intervalMs greater than 0, not " + std::to_string(intervalMs));
+  }
+  RTC_STATS_SUBSCRIPTION_OPTIONS options;
+  options.intervalMs = intervalMs;
+  options.filter = RTCStatsFilter(
+          types.FromMaybe(std::vector<std::string>()),
+          members.FromMaybe(std::vector<std::string>()));
+  return Pure(options);
+}
+
+}  // namespace node_webrtc
+
+#define DICT(X) RTC_STATS_SUBSCRIPTION_OPTIONS ## X
+#include "src/dictionaries/macros/impls.h"
+#undef DICT
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstdint>
+
+#include "src/dictionaries/node_webrtc/rtc_stats_filter.h"
+
+// IWYU pragma: no_include "src/dictionaries/macros/impls.h"
+
+namespace node_webrtc {
+
+struct RTCStatsSubscriptionOptions {
+  uint32_t intervalMs = 1000;
+  RTCStatsFilter filter;
+};
+
+}  // namespace node_webrtc
+
+#define RTC_STATS_SUBSCRIPTION_OPTIONS RTCStatsSubscriptionOptions
+#define RTC_STATS_SUBSCRIPTION_OPTIONS_LIST \
+  DICT_DEFAULT(uint32_t, intervalMs, "intervalMs", 1000) \
+  DICT_OPTIONAL(std::vector<std::string>, types, "types") \
+  DICT_OPTIONAL(std::vector<std::string>, members, "members")
+
+#define DICT(X) RTC_STATS_SUBSCRIPTION_OPTIONS ## X
+#include "src/dictionaries/macros/decls.h"
+#undef DICT
@@ -6,6 +6,15 @@ namespace webrtc { class RTCStats; }
 
 namespace node_webrtc {
 
+struct RTCStatsFilter;
+
+// An RTCStats object to be converted with only the members |filter| selects.
+struct FilteredRTCStats {
+  const webrtc::RTCStats* stats;
+  const RTCStatsFilter* filter;
+};
+
 DECLARE_TO_NAPI(const webrtc::RTCStats*)
+DECLARE_TO_NAPI(FilteredRTCStats)
 
 }  // namespace node_webrtc
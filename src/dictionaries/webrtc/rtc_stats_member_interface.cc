@@ -48,4 +48,29 @@ TO_NAPI_IMPL(const webrtc::RTCStatsMemberInterface*, pair) {
   }
 }
 
+bool GetNumber(const webrtc::RTCStatsMemberInterface& member, double* number) {
+  switch (member.type()) {
+    case webrtc::RTCStatsMemberInterface::Type::kBool:
+      *number = *member.cast_to<webrtc::RTCStatsMember<bool>>() ? 1 : 0;
+      return true;
+    case webrtc::RTCStatsMemberInterface::Type::kInt32:
+      *number = *member.cast_to<webrtc::RTCStatsMember<int32_t>>();
+      return true;
+    case webrtc::RTCStatsMemberInterface::Type::kUint32:
+      *number = *member.cast_to<webrtc::RTCStatsMember<uint32_t>>();
+      return true;
+    case webrtc::RTCStatsMemberInterface::Type::kInt64:
+      *number = static_cast<double>(*member.cast_to<webrtc::RTCStatsMember<int64_t>>());
+      return true;
+    case webrtc::RTCStatsMemberInterface::Type::kUint64:
+      *number = static_cast<double>(*member.cast_to<webrtc::RTCStatsMember<uint64_t>>());
+      return true;
+    case webrtc::RTCStatsMemberInterface::Type::kDouble:
+      *number = *member.cast_to<webrtc::RTCStatsMember<double>>();
+      return true;
+    default:
+      return false;
+  }
+}
+
 } // namespace node_webrtc
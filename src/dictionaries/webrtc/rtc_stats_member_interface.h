@@ -8,4 +8,8 @@ namespace node_webrtc {
 
 DECLARE_TO_NAPI(const webrtc::RTCStatsMemberInterface*)
 
+// If |member| is a boolean (0 or 1) or number, store it in |number| and return
+// true; otherwise, return false. 64-bit integers lose precision beyond 2^53.
+bool GetNumber(const webrtc::RTCStatsMemberInterface& member, double* number);
+
 }  // namespace node_webrtc
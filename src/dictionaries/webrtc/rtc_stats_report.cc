@@ -5,6 +5,7 @@
 #include <webrtc/api/stats/rtc_stats_report.h>  // IWYU pragma: keep
 
 #include "src/converters/object.h"
+#include "src/dictionaries/node_webrtc/rtc_stats_filter.h"
 #include "src/dictionaries/webrtc/rtc_stats.h"  // IWYU pragma: keep
 #include "src/functional/validation.h"
 
@@ -55,11 +56,19 @@ static Maybe<Errors> DoSet(Napi::Object map, std::string key, T value) {
 }
 
 TO_NAPI_IMPL(rtc::scoped_refptr<webrtc::RTCStatsReport>, pair) {
+  return From<Napi::Value>(std::make_pair(pair.first, FilteredRTCStatsReport {pair.second, nullptr}));
+}
+
+TO_NAPI_IMPL(FilteredRTCStatsReport, pair) {
   return CreateMap(pair.first).FlatMap<Napi::Value>([value = pair.second](auto map) {
     auto env = map.Env();
     Napi::EscapableHandleScope scope(env);
-    for (const webrtc::RTCStats& stats : *value) {
-      auto result = DoSet(map, stats.id(), &stats);
+    auto filter = value.filter.get();
+    for (const webrtc::RTCStats& stats : *value.report) {
+      if (filter && !filter->HasType(stats.type())) {
+        continue;
+      }
+      auto result = DoSet(map, stats.id(), FilteredRTCStats {&stats, filter});
       if (result.IsJust()) {
         return Validation<Napi::Value>::Invalid(result.UnsafeFromJust());
       }
@@ -1,12 +1,25 @@
 #pragma once
 
+#include <memory>
+
+#include <webrtc/api/scoped_refptr.h>
+
 #include "src/converters/napi.h"
 
-namespace rtc { template <typename T> class scoped_refptr; }
 namespace webrtc { class RTCStatsReport; }
 
 namespace node_webrtc {
 
+struct RTCStatsFilter;
+
+// An RTCStatsReport to be converted with only the stats objects and members
+// |filter| selects. A null |filter| selects everything.
+struct FilteredRTCStatsReport {
+  rtc::scoped_refptr<webrtc::RTCStatsReport> report;
+  std::shared_ptr<const RTCStatsFilter> filter;
+};
+
 DECLARE_TO_NAPI(rtc::scoped_refptr<webrtc::RTCStatsReport>)
+DECLARE_TO_NAPI(FilteredRTCStatsReport)
 
 }  // namespace node_webrtc
@@ -0,0 +1,14 @@
+#pragma once
+
+// IWYU pragma: no_include "src/enums/macros/impls.h"
+
+#define AUDIO_CAPTURER_TYPE AudioCapturerType
+#define AUDIO_CAPTURER_TYPE_NAME "AudioCapturerType"
+#define AUDIO_CAPTURER_TYPE_LIST \
+  ENUM_SUPPORTED(kZeroAudioCapturer, "zero") \
+  ENUM_SUPPORTED(kNoAudioCapturer, "none")
+
+#define ENUM(X) AUDIO_CAPTURER_TYPE ## X
+#include "src/enums/macros/def.h"
+#include "src/enums/macros/decls.h"
+#undef ENUM
@@ -0,0 +1,5 @@
+#include "src/enums/node_webrtc/audio_renderer_type.h"
+
+#define ENUM(X) AUDIO_RENDERER_TYPE ## X
+#include "src/enums/macros/impls.h"
+#undef ENUM
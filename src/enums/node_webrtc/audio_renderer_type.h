@@ -0,0 +1,15 @@
+#pragma once
+
+// IWYU pragma: no_include "src/enums/macros/impls.h"
+
+#define AUDIO_RENDERER_TYPE AudioRendererType
+#define AUDIO_RENDERER_TYPE_NAME "AudioRendererType"
+#define AUDIO_RENDERER_TYPE_LIST \
+  ENUM_SUPPORTED(kDiscardAudioRenderer, "discard") \
+  ENUM_SUPPORTED(kWavFileAudioRenderer, "wav") \
+  ENUM_SUPPORTED(kNoAudioRenderer, "none")
+
+#define ENUM(X) AUDIO_RENDERER_TYPE ## X
+#include "src/enums/macros/def.h"
+#include "src/enums/macros/decls.h"
+#undef ENUM
@@ -0,0 +1,5 @@
+#include "src/enums/node_webrtc/socket_server_type.h"
+
+#define ENUM(X) SOCKET_SERVER_TYPE ## X
+#include "src/enums/macros/impls.h"
+#undef ENUM
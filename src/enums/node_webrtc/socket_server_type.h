@@ -0,0 +1,14 @@
+#pragma once
+
+// IWYU pragma: no_include "src/enums/macros/impls.h"
+
+#define SOCKET_SERVER_TYPE SocketServerType
+#define SOCKET_SERVER_TYPE_NAME "SocketServerType"
+#define SOCKET_SERVER_TYPE_LIST \
+  ENUM_SUPPORTED(kPhysicalSocketServer, "physical") \
+  ENUM_SUPPORTED(kEpollSocketServer, "epoll")
+
+#define ENUM(X) SOCKET_SERVER_TYPE ## X
+#include "src/enums/macros/def.h"
+#include "src/enums/macros/decls.h"
+#undef ENUM
@@ -49,16 +49,13 @@ Napi::Value LegacyStatsReport::Names(const Napi::CallbackInfo& info) {
 Napi::Value LegacyStatsReport::Stat(const Napi::CallbackInfo& info) {
   CONVERT_ARGS_OR_THROW_AND_RETURN_NAPI(info, requested, std::string)
 
-  Napi::Value found = info.Env().Undefined();
-  for (const auto& pair : _stats) {
-    auto name = pair.first;
-    if (requested == name) {
-      CONVERT_OR_THROW_AND_RETURN_NAPI(info.Env(), pair.second, result, Napi::Value)
-      found = result;
-    }
+  auto stat = _stats.find(requested);
+  if (stat == _stats.end()) {
+    return info.Env().Undefined();
   }
 
-  return found;
+  CONVERT_OR_THROW_AND_RETURN_NAPI(info.Env(), stat->second, result, Napi::Value)
+  return result;
 }
 
 Napi::Value LegacyStatsReport::GetTimestamp(const Napi::CallbackInfo& info) {
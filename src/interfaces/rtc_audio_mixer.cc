@@ -0,0 +1,445 @@
+/* Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#include "src/interfaces/rtc_audio_mixer.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <tuple>
+#include <utility>
+
+#include <absl/memory/memory.h>
+#include <webrtc/audio/utility/audio_frame_operations.h>
+#include <webrtc/common_audio/resampler/include/push_resampler.h>
+#include <webrtc/modules/audio_mixer/audio_mixer_impl.h>
+#include <webrtc/modules/audio_mixer/output_rate_calculator.h>
+#include <webrtc/rtc_base/helpers.h>
+#include <webrtc/rtc_base/logging.h>
+#include <webrtc/rtc_base/platform_thread.h>
+#include <webrtc/rtc_base/ref_counted_object.h>
+#include <webrtc/rtc_base/thread.h>
+#include <webrtc/rtc_base/time_utils.h>
+
+#include "src/converters.h"
+#include "src/converters/arguments.h"
+#include "src/converters/napi.h"
+#include "src/dictionaries/node_webrtc/rtc_audio_mixer_init.h"
+#include "src/functional/maybe.h"
+#include "src/interfaces/media_stream_track.h"
+#include "src/interfaces/rtc_audio_source.h"
+#include "src/interfaces/rtc_peer_connection/peer_connection_factory.h"
+#include "src/node/events.h"
+
+namespace node_webrtc {
+
+namespace {
+
+constexpr int kFrameLengthUs = 10000;
+
+// An input must be the loudest for this many consecutive frames (200 ms)
+// before it becomes the active speaker.
+constexpr int kActiveSpeakerHoldFrames = 20;
+
+// Each input buffers up to this many 10 ms frames (40 ms), so that jitter
+// between its producer and the mixing thread neither drops nor mutes audio.
+constexpr size_t kInputBufferFrames = 4;
+
+// Mean square sample value below which an input is considered silent: -50
+// dBov, or 10^-5 times the mean square of a full scale signal.
+constexpr double kActiveSpeakerMinLevel = 32768.0 * 32768.0 * 1e-5;
+
+class FixedOutputRateCalculator : public webrtc::OutputRateCalculator {
+ public:
+  explicit FixedOutputRateCalculator(int sample_rate_hz): _sample_rate_hz(sample_rate_hz) {}
+
+  int CalculateOutputRate(const std::vector<int>&) override {
+    return _sample_rate_hz;
+  }
+
+ private:
+  const int _sample_rate_hz;
+};
+
+}  // namespace
+
+/**
+ * An RTCAudioMixer::Input receives 10 ms of audio from a MediaStreamTrack
+ * and hands it, resampled and scaled by its gain, to the webrtc::AudioMixer.
+ */
+class RTCAudioMixer::Input
+  : public webrtc::AudioMixer::Source
+  , public webrtc::AudioTrackSinkInterface {
+ public:
+  Input(rtc::scoped_refptr<webrtc::AudioTrackInterface> track, int ssrc, int sample_rate_hz, float gain)
+    : _track(std::move(track)), _ssrc(ssrc), _sample_rate_hz(sample_rate_hz), _gain(gain) {}
+
+  rtc::scoped_refptr<webrtc::AudioTrackInterface> track() const { return _track; }
+
+  double level() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _level;
+  }
+
+  void SetGain(float gain) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _gain = gain;
+  }
+
+  // AudioTrackSinkInterface
+  void OnData(
+      const void* audio_data,
+      int bits_per_sample,
+      int sample_rate,
+      size_t number_of_channels,
+      size_t number_of_frames) override {
+    if (bits_per_sample != 16) {
+      return;
+    }
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_buffered == kInputBufferFrames) {
+      // The producer is ahead of the mixing thread; drop the oldest frame.
+      _first = (_first + 1) % kInputBufferFrames;
+      _buffered--;
+    }
+    _frames[(_first + _buffered) % kInputBufferFrames].UpdateFrame(
+        0,
+        static_cast<const int16_t*>(audio_data),
+        number_of_frames,
+        sample_rate,
+        webrtc::AudioFrame::kNormalSpeech,
+        webrtc::AudioFrame::kVadUnknown,
+        number_of_channels);
+    _buffered++;
+  }
+
+  // AudioMixer::Source
+  AudioFrameInfo GetAudioFrameWithInfo(int sample_rate_hz, webrtc::AudioFrame* audio_frame) override {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!_buffered) {
+      _level = 0;
+      return AudioFrameInfo::kMuted;
+    }
+    auto& frame = _frames[_first];
+    _first = (_first + 1) % kInputBufferFrames;
+    _buffered--;
+
+    if (frame.sample_rate_hz_ == sample_rate_hz) {
+      audio_frame->CopyFrom(frame);
+    } else {
+      _resampler.InitializeIfNeeded(frame.sample_rate_hz_, sample_rate_hz, frame.num_channels_);
+      auto length = _resampler.Resample(
+              frame.data(),
+              frame.samples_per_channel_ * frame.num_channels_,
+              audio_frame->mutable_data(),
+              webrtc::AudioFrame::kMaxDataSizeSamples);
+      if (length < 0) {
+        return AudioFrameInfo::kError;
+      }
+      audio_frame->num_channels_ = frame.num_channels_;
+      audio_frame->samples_per_channel_ = static_cast<size_t>(length) / frame.num_channels_;
+      audio_frame->sample_rate_hz_ = sample_rate_hz;
+    }
+
+    if (_gain != 1.0f) {
+      webrtc::AudioFrameOperations::ScaleWithSat(_gain, audio_frame);
+    }
+
+    auto samples = audio_frame->data();
+    auto length = audio_frame->samples_per_channel_ * audio_frame->num_channels_;
+    double sumOfSquares = 0;
+    for (size_t i = 0; i < length; i++) {
+      sumOfSquares += static_cast<double>(samples[i]) * samples[i];
+    }
+    _level = length ? sumOfSquares / length : 0;
+
+    return AudioFrameInfo::kNormal;
+  }
+
+  int Ssrc() const override {
+    return _ssrc;
+  }
+
+  int PreferredSampleRate() const override {
+    return _sample_rate_hz;
+  }
+
+ private:
+  const rtc::scoped_refptr<webrtc::AudioTrackInterface> _track;
+  const int _ssrc;
+  const int _sample_rate_hz;
+
+  std::mutex _mutex{};
+  float _gain;
+  double _level = 0;
+  // A ring buffer of 10 ms frames, oldest first.
+  std::array<webrtc::AudioFrame, kInputBufferFrames> _frames;
+  size_t _first = 0;
+  size_t _buffered = 0;
+  webrtc::PushResampler<int16_t> _resampler;
+};
+
+Napi::FunctionReference& RTCAudioMixer::constructor() {
+  static Napi::FunctionReference constructor;
+  return constructor;
+}
+
+RTCAudioMixer::RTCAudioMixer(const Napi::CallbackInfo& info)
+  : AsyncObjectWrapWithLoop<RTCAudioMixer>("RTCAudioMixer", *this, info) {
+  auto env = info.Env();
+
+  if (!info.IsConstructCall()) {
+    Napi::TypeError::New(env, "Use the new operator to construct an RTCAudioMixer.").ThrowAsJavaScriptException();
+    return;
+  }
+
+  CONVERT_ARGS_OR_THROW_AND_RETURN_VOID_NAPI(info, maybeInit, Maybe<RTCAudioMixerInit>)
+  auto init = maybeInit.FromMaybe(RTCAudioMixerInit({48000, 1}));
+
+  _factory = PeerConnectionFactory::GetOrCreateDefault();
+  _source = new rtc::RefCountedObject<RTCAudioTrackSource>();
+  _mixer = webrtc::AudioMixerImpl::Create(
+          absl::make_unique<FixedOutputRateCalculator>(init.sampleRate),
+          true);
+  _sampleRate = init.sampleRate;
+  _channelCount = init.channelCount;
+
+  _thread = absl::make_unique<rtc::PlatformThread>(
+          RTCAudioMixer::Run, this, "RTCAudioMixer", rtc::kHighPriority);
+  _thread->Start();
+}
+
+RTCAudioMixer::~RTCAudioMixer() {
+  StopMixing();
+  _source = nullptr;
+  _mixer = nullptr;
+  if (_factory) {
+    PeerConnectionFactory::Release();
+    _factory = nullptr;
+  }
+}
+
+void RTCAudioMixer::Run(void* obj) {
+  static_cast<RTCAudioMixer*>(obj)->ProcessAudio();
+}
+
+void RTCAudioMixer::ProcessAudio() {
+  int64_t time_us = rtc::TimeMicros();
+  bool logged_once = false;
+  while (!_stopThread) {
+    _mixer->Mix(_channelCount, &_mixedFrame);
+    _source->PushFrame(_mixedFrame);
+    UpdateActiveSpeaker();
+
+    time_us += kFrameLengthUs;
+
+    int64_t time_left_us = time_us - rtc::TimeMicros();
+    if (time_left_us < 0) {
+      if (!logged_once) {
+        RTC_LOG(LS_ERROR) << "RTCAudioMixer is too slow";
+        logged_once = true;
+      }
+    } else {
+      while (time_left_us > 1000) {
+        if (rtc::Thread::SleepMs(time_left_us / 1000)) {  // NOLINT
+          break;
+        }
+        time_left_us = time_us - rtc::TimeMicros();
+      }
+    }
+  }
+}
+
+void RTCAudioMixer::UpdateActiveSpeaker() {
+  std::lock_guard<std::mutex> lock(_mutex);
+
+  Input* loudest = nullptr;
+  double loudestLevel = kActiveSpeakerMinLevel;
+  for (auto const& input : _inputs) {
+    auto level = input->level();
+    if (level > loudestLevel) {
+      loudest = input.get();
+      loudestLevel = level;
+    }
+  }
+
+  if (!loudest || loudest == _activeSpeaker) {
+    _activeSpeakerCandidate = nullptr;
+    _activeSpeakerCandidateFrames = 0;
+    return;
+  }
+
+  if (loudest != _activeSpeakerCandidate) {
+    _activeSpeakerCandidate = loudest;
+    _activeSpeakerCandidateFrames = 0;
+  }
+
+  if (++_activeSpeakerCandidateFrames < kActiveSpeakerHoldFrames) {
+    return;
+  }
+
+  _activeSpeaker = loudest;
+  _activeSpeakerCandidate = nullptr;
+  _activeSpeakerCandidateFrames = 0;
+
+  rtc::scoped_refptr<webrtc::MediaStreamTrackInterface> track = _activeSpeaker->track();
+  Dispatch(CreateCallback<RTCAudioMixer>([this, track]() {
+    auto env = Env();
+    Napi::HandleScope scope(env);
+    auto object = Napi::Object::New(env);
+    object.Set("type", Napi::String::New(env, "activespeakerchange"));
+    object.Set("track", MediaStreamTrack::wrap()->GetOrCreate(_factory, track)->Value());
+    MakeCallback("dispatchEvent", { object });
+  }));
+}
+
+void RTCAudioMixer::StopMixing() {
+  if (_thread) {
+    _stopThread = true;
+    _thread->Stop();
+    _thread = nullptr;
+  }
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  for (auto const& input : _inputs) {
+    input->track()->RemoveSink(input.get());
+    _mixer->RemoveSource(input.get());
+  }
+  _inputs.clear();
+  _activeSpeaker = nullptr;
+  _activeSpeakerCandidate = nullptr;
+}
+
+void RTCAudioMixer::Stop() {
+  if (!_stopped) {
+    _stopped = true;
+    StopMixing();
+  }
+  AsyncObjectWrapWithLoop<RTCAudioMixer>::Stop();
+}
+
+Napi::Value RTCAudioMixer::AddInput(const Napi::CallbackInfo& info) {
+  auto env = info.Env();
+  CONVERT_ARGS_OR_THROW_AND_RETURN_NAPI(info, args, std::tuple<rtc::scoped_refptr<webrtc::AudioTrackInterface> COMMA Maybe<double>>)
+  auto track = std::get<0>(args);
+  auto gain = std::get<1>(args).FromMaybe(1);
+
+  if (_stopped) {
+    Napi::Error::New(env, "Cannot addInput; RTCAudioMixer is stopped").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  auto existing = std::find_if(_inputs.begin(), _inputs.end(), [&track](auto const& input) {
+    return input->track() == track;
+  });
+  if (existing != _inputs.end()) {
+    (*existing)->SetGain(static_cast<float>(gain));
+    return env.Undefined();
+  }
+
+  static int nextSsrc = 0;
+  auto input = absl::make_unique<Input>(track, ++nextSsrc, _sampleRate, static_cast<float>(gain));
+  _mixer->AddSource(input.get());
+  track->AddSink(input.get());
+  _inputs.push_back(std::move(input));
+
+  return env.Undefined();
+}
+
+Napi::Value RTCAudioMixer::RemoveInput(const Napi::CallbackInfo& info) {
+  auto env = info.Env();
+  CONVERT_ARGS_OR_THROW_AND_RETURN_NAPI(info, track, rtc::scoped_refptr<webrtc::AudioTrackInterface>)
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  auto existing = std::find_if(_inputs.begin(), _inputs.end(), [&track](auto const& input) {
+    return input->track() == track;
+  });
+  if (existing == _inputs.end()) {
+    return env.Undefined();
+  }
+
+  auto input = existing->get();
+  track->RemoveSink(input);
+  _mixer->RemoveSource(input);
+  if (_activeSpeaker == input) {
+    _activeSpeaker = nullptr;
+  }
+  if (_activeSpeakerCandidate == input) {
+    _activeSpeakerCandidate = nullptr;
+    _activeSpeakerCandidateFrames = 0;
+  }
+  _inputs.erase(existing);
+
+  return env.Undefined();
+}
+
+Napi::Value RTCAudioMixer::SetGain(const Napi::CallbackInfo& info) {
+  auto env = info.Env();
+  CONVERT_ARGS_OR_THROW_AND_RETURN_NAPI(info, args, std::tuple<rtc::scoped_refptr<webrtc::AudioTrackInterface> COMMA double>)
+  auto track = std::get<0>(args);
+  auto gain = std::get<1>(args);
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  auto existing = std::find_if(_inputs.begin(), _inputs.end(), [&track](auto const& input) {
+    return input->track() == track;
+  });
+  if (existing == _inputs.end()) {
+    Napi::Error::New(env, "Cannot setGain; MediaStreamTrack is not an input").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  (*existing)->SetGain(static_cast<float>(gain));
+
+  return env.Undefined();
+}
+
+Napi::Value RTCAudioMixer::CreateTrack(const Napi::CallbackInfo&) {
+  auto track = _factory->factory()->CreateAudioTrack(rtc::CreateRandomUuid(), _source);
+  return MediaStreamTrack::wrap()->GetOrCreate(_factory, track)->Value();
+}
+
+Napi::Value RTCAudioMixer::JsStop(const Napi::CallbackInfo& info) {
+  Stop();
+  return info.Env().Undefined();
+}
+
+Napi::Value RTCAudioMixer::GetActiveSpeaker(const Napi::CallbackInfo& info) {
+  rtc::scoped_refptr<webrtc::MediaStreamTrackInterface> track;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_activeSpeaker) {
+      track = _activeSpeaker->track();
+    }
+  }
+  return track
+      ? MediaStreamTrack::wrap()->GetOrCreate(_factory, track)->Value()
+      : info.Env().Null();
+}
+
+Napi::Value RTCAudioMixer::GetStopped(const Napi::CallbackInfo& info) {
+  CONVERT_OR_THROW_AND_RETURN_NAPI(info.Env(), _stopped, result, Napi::Value)
+  return result;
+}
+
+void RTCAudioMixer::Init(Napi::Env env, Napi::Object exports) {
+  auto func = DefineClass(env, "RTCAudioMixer", {
+    InstanceMethod("addInput", &RTCAudioMixer::AddInput),
+    InstanceMethod("removeInput", &RTCAudioMixer::RemoveInput),
+    InstanceMethod("setGain", &RTCAudioMixer::SetGain),
+    InstanceMethod("createTrack", &RTCAudioMixer::CreateTrack),
+    InstanceMethod("stop", &RTCAudioMixer::JsStop),
+    InstanceAccessor("activeSpeaker", &RTCAudioMixer::GetActiveSpeaker, nullptr),
+    InstanceAccessor("stopped", &RTCAudioMixer::GetStopped, nullptr)
+  });
+
+  constructor() = Napi::Persistent(func);
+  constructor().SuppressDestruct();
+
+  exports.Set("RTCAudioMixer", func);
+}
+
+}  // namespace node_webrtc
@@ -0,0 +1,86 @@
+/* Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <node-addon-api/napi.h>
+#include <webrtc/api/audio/audio_frame.h>
+#include <webrtc/api/audio/audio_mixer.h>
+#include <webrtc/api/media_stream_interface.h>
+#include <webrtc/api/scoped_refptr.h>
+
+#include "src/node/async_object_wrap_with_loop.h"
+
+namespace rtc { class PlatformThread; }
+
+namespace node_webrtc {
+
+class PeerConnectionFactory;
+class RTCAudioTrackSource;
+
+/**
+ * RTCAudioMixer mixes any number of audio MediaStreamTracks into a single
+ * local audio MediaStreamTrack using webrtc::AudioMixerImpl. Mixing happens
+ * every 10 ms on a dedicated thread; JavaScript is only called back when the
+ * active speaker changes.
+ */
+class RTCAudioMixer
+  : public AsyncObjectWrapWithLoop<RTCAudioMixer> {
+ public:
+  explicit RTCAudioMixer(const Napi::CallbackInfo&);
+
+  ~RTCAudioMixer() override;
+
+  static void Init(Napi::Env, Napi::Object);
+
+  static Napi::FunctionReference& constructor();
+
+ protected:
+  void Stop() override;
+
+ private:
+  class Input;
+
+  static void Run(void*);
+
+  void ProcessAudio();
+  void UpdateActiveSpeaker();
+  void StopMixing();
+
+  Napi::Value AddInput(const Napi::CallbackInfo&);
+  Napi::Value RemoveInput(const Napi::CallbackInfo&);
+  Napi::Value SetGain(const Napi::CallbackInfo&);
+  Napi::Value CreateTrack(const Napi::CallbackInfo&);
+  Napi::Value JsStop(const Napi::CallbackInfo&);
+
+  Napi::Value GetActiveSpeaker(const Napi::CallbackInfo&);
+  Napi::Value GetStopped(const Napi::CallbackInfo&);
+
+  PeerConnectionFactory* _factory = nullptr;
+  rtc::scoped_refptr<RTCAudioTrackSource> _source;
+  rtc::scoped_refptr<webrtc::AudioMixer> _mixer;
+  int _sampleRate;
+  size_t _channelCount;
+
+  std::mutex _mutex{};
+  std::vector<std::unique_ptr<Input>> _inputs;
+  Input* _activeSpeaker = nullptr;
+  Input* _activeSpeakerCandidate = nullptr;
+  int _activeSpeakerCandidateFrames = 0;
+
+  webrtc::AudioFrame _mixedFrame;
+  std::unique_ptr<rtc::PlatformThread> _thread;
+  std::atomic<bool> _stopThread = {false};
+  bool _stopped = false;
+};
+
+}  // namespace node_webrtc
@@ -11,11 +11,16 @@
 #include <cstring>
 #include <memory>
 #include <type_traits>
+#include <tuple>
 #include <utility>
 
+#include <webrtc/api/array_view.h>
+#include <webrtc/common_audio/vad/include/vad.h>
+
 #include "src/converters.h"
 #include "src/converters/arguments.h"
 #include "src/converters/napi.h"
+#include "src/dictionaries/node_webrtc/rtc_audio_sink_init.h"
 #include "src/dictionaries/node_webrtc/rtc_on_data_event_dict.h"
 #include "src/functional/maybe.h"
 #include "src/functional/validation.h"
@@ -38,12 +43,27 @@ RTCAudioSink::RTCAudioSink(const Napi::CallbackInfo& info)
     return;
   }
 
-  CONVERT_ARGS_OR_THROW_AND_RETURN_VOID_NAPI(info, track, rtc::scoped_refptr<webrtc::AudioTrackInterface>)
+  CONVERT_ARGS_OR_THROW_AND_RETURN_VOID_NAPI(info, args, std::tuple<rtc::scoped_refptr<webrtc::AudioTrackInterface> COMMA Maybe<RTCAudioSinkInit>>)
+  auto init = std::get<1>(args).FromMaybe(RTCAudioSinkInit());
+
+  if (init.vad) {
+    _vad = webrtc::CreateVad(static_cast<webrtc::Vad::Aggressiveness>(init.vadAggressiveness));
+  }
+  _vadHangover = init.vadHangover;
+  _suppressSilence = init.suppressSilence;
+  _levelInterval = init.levelInterval;
 
-  _track = std::move(track);
+  _track = std::get<0>(args);
   _track->AddSink(this);
 }
 
+RTCAudioSink::~RTCAudioSink() = default;
+
+Napi::Value RTCAudioSink::GetSpeaking(const Napi::CallbackInfo& info) {
+  CONVERT_OR_THROW_AND_RETURN_NAPI(info.Env(), _speaking, result, Napi::Value)
+  return result;
+}
+
 Napi::Value RTCAudioSink::GetStopped(const Napi::CallbackInfo& info) {
   CONVERT_OR_THROW_AND_RETURN_NAPI(info.Env(), _stopped, result, Napi::Value)
   return result;
@@ -69,24 +89,28 @@ void RTCAudioSink::OnData(
     int sample_rate,
     size_t number_of_channels,
     size_t number_of_frames) {
-  auto byte_length = number_of_channels * number_of_frames * bits_per_sample / 8;
-  std::unique_ptr<uint8_t[]> audio_data_copy(new uint8_t[byte_length]);
-  if (!audio_data_copy) {
-    // TODO(mroberts): Throw an error somehow?
+  if (bits_per_sample == 16 && (_vad || _levelInterval)) {
+    Analyze(static_cast<const int16_t*>(audio_data), sample_rate, number_of_channels, number_of_frames);
+  }
+
+  if (_suppressSilence && !_voiceActive) {
     return;
   }
+
+  auto byte_length = number_of_channels * number_of_frames * bits_per_sample / 8;
+  std::shared_ptr<uint8_t> audio_data_copy(new uint8_t[byte_length], std::default_delete<uint8_t[]>());
   memcpy(audio_data_copy.get(), audio_data, byte_length);
 
   Dispatch(CreateCallback<RTCAudioSink>([
              this,
-             audio_data_copy = std::move(audio_data_copy),
+             audio_data_copy,
              bits_per_sample,
              sample_rate,
              number_of_channels,
              number_of_frames
-  ]() mutable {
+  ]() {
     RTCOnDataEventDict dict({
-      audio_data_copy.release(),
+      audio_data_copy,
       static_cast<uint8_t>(bits_per_sample),
       static_cast<uint16_t>(sample_rate),
       static_cast<uint8_t>(number_of_channels),
@@ -98,8 +122,6 @@ void RTCAudioSink::OnData(
     auto maybeValue = From<Napi::Value>(std::make_pair(env, dict));
     if (maybeValue.IsInvalid()) {
       // TODO(mroberts): Should raise an error; although this really shouldn't happen.
-      // HACK(mroberts): I'd rather we use a smart pointer.
-      delete[] dict.samples;
       return;
     }
     auto object = maybeValue.UnsafeFromValid().ToObject();
@@ -108,8 +130,94 @@ void RTCAudioSink::OnData(
   }));
 }
 
+static bool IsVadSupported(int sample_rate, size_t number_of_frames) {
+  if (sample_rate != 8000 && sample_rate != 16000 && sample_rate != 32000 && sample_rate != 48000) {
+    return false;
+  }
+  auto frames_per_10ms = static_cast<size_t>(sample_rate / 100);
+  return number_of_frames == frames_per_10ms
+      || number_of_frames == 2 * frames_per_10ms
+      || number_of_frames == 3 * frames_per_10ms;
+}
+
+void RTCAudioSink::Analyze(
+    const int16_t* samples,
+    int sample_rate,
+    size_t number_of_channels,
+    size_t number_of_frames) {
+  if (!sample_rate) {
+    return;
+  }
+
+  // Both the VAD and the level meter operate on mono audio.
+  auto mono = samples;
+  if (number_of_channels > 1) {
+    _downmixed.resize(number_of_frames);
+    for (size_t i = 0; i < number_of_frames; i++) {
+      int32_t sum = 0;
+      for (size_t j = 0; j < number_of_channels; j++) {
+        sum += samples[i * number_of_channels + j];
+      }
+      _downmixed[i] = static_cast<int16_t>(sum / static_cast<int32_t>(number_of_channels));
+    }
+    mono = _downmixed.data();
+  }
+
+  auto elapsedMs = number_of_frames * 1000 / sample_rate;
+
+  if (_vad) {
+    // The VAD only supports 10, 20, or 30 ms of audio at 8, 16, 32, or 48 kHz
+    // (and RTC_NOTREACHEDs otherwise); anything else is treated as voice, so
+    // that it is never suppressed.
+    auto activity = IsVadSupported(sample_rate, number_of_frames)
+        ? _vad->VoiceActivity(mono, number_of_frames, sample_rate)
+        : webrtc::Vad::kActive;
+    auto wasVoiceActive = _voiceActive;
+    if (activity != webrtc::Vad::kPassive) {
+      _voiceActive = true;
+      _silentMs = 0;
+    } else if (_voiceActive) {
+      _silentMs += elapsedMs;
+      if (_silentMs >= _vadHangover) {
+        _voiceActive = false;
+      }
+    }
+    if (_voiceActive != wasVoiceActive) {
+      auto speaking = _voiceActive;
+      Dispatch(CreateCallback<RTCAudioSink>([this, speaking]() {
+        _speaking = speaking;
+        auto env = Env();
+        Napi::HandleScope scope(env);
+        auto object = Napi::Object::New(env);
+        object.Set("type", Napi::String::New(env, "speakingchange"));
+        object.Set("speaking", Napi::Boolean::New(env, speaking));
+        MakeCallback("dispatchEvent", { object });
+      }));
+    }
+  }
+
+  if (_levelInterval) {
+    _level.Analyze(rtc::ArrayView<const int16_t>(mono, number_of_frames));
+    _levelElapsedMs += elapsedMs;
+    if (_levelElapsedMs >= _levelInterval) {
+      _levelElapsedMs = 0;
+      // RmsLevel reports the level as a positive number of dB below full scale.
+      auto level = -_level.Average();
+      Dispatch(CreateCallback<RTCAudioSink>([this, level]() {
+        auto env = Env();
+        Napi::HandleScope scope(env);
+        auto object = Napi::Object::New(env);
+        object.Set("type", Napi::String::New(env, "level"));
+        object.Set("level", Napi::Number::New(env, level));
+        MakeCallback("dispatchEvent", { object });
+      }));
+    }
+  }
+}
+
 void RTCAudioSink::Init(Napi::Env env, Napi::Object exports) {
   auto func = DefineClass(env, "RTCAudioSink", {
+    InstanceAccessor("speaking", &RTCAudioSink::GetSpeaking, nullptr),
     InstanceAccessor("stopped", &RTCAudioSink::GetStopped, nullptr),
     InstanceMethod("stop", &RTCAudioSink::JsStop)
   });
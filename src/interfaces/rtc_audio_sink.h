@@ -8,13 +8,19 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
 
 #include <node-addon-api/napi.h>
 #include <webrtc/api/media_stream_interface.h>
 #include <webrtc/api/scoped_refptr.h>
+#include <webrtc/modules/audio_processing/rms_level.h>
 
 #include "src/node/async_object_wrap_with_loop.h"
 
+namespace webrtc { class Vad; }
+
 namespace node_webrtc {
 
 class RTCAudioSink
@@ -23,6 +29,8 @@ class RTCAudioSink
  public:
   explicit RTCAudioSink(const Napi::CallbackInfo&);
 
+  ~RTCAudioSink() override;
+
   static void Init(Napi::Env, Napi::Object);
 
   void OnData(
@@ -38,11 +46,27 @@ class RTCAudioSink
   void Stop() override;
 
  private:
+  void Analyze(const int16_t* samples, int sample_rate, size_t number_of_channels, size_t number_of_frames);
+
+  Napi::Value GetSpeaking(const Napi::CallbackInfo&);
   Napi::Value GetStopped(const Napi::CallbackInfo&);
 
   Napi::Value JsStop(const Napi::CallbackInfo&);
 
+  bool _speaking = false;
   bool _stopped = false;
+
+  // The following are only accessed on the thread calling OnData.
+  std::unique_ptr<webrtc::Vad> _vad;
+  uint16_t _vadHangover = 0;
+  bool _suppressSilence = false;
+  bool _voiceActive = false;
+  size_t _silentMs = 0;
+  uint16_t _levelInterval = 0;
+  size_t _levelElapsedMs = 0;
+  webrtc::RmsLevel _level;
+  std::vector<int16_t> _downmixed;
+
   rtc::scoped_refptr<webrtc::AudioTrackInterface> _track;
 };
 
@@ -7,10 +7,12 @@
  */
 #pragma once
 
-#include <atomic>
 #include <memory>
+#include <mutex>
+#include <set>
 
 #include <node-addon-api/napi.h>
+#include <webrtc/api/audio/audio_frame.h>
 #include <webrtc/api/media_stream_interface.h>
 #include <webrtc/api/scoped_refptr.h>
 #include <webrtc/pc/local_audio_source.h>
@@ -37,33 +39,56 @@ class RTCAudioTrackSource : public webrtc::LocalAudioSource {
     return false;
   }
 
-  void PushData(RTCOnDataEventDict dict) {
-    webrtc::AudioTrackSinkInterface* sink = _sink;
-    if (sink && dict.numberOfFrames.IsJust()) {
+  /**
+   * Push samples to the sinks. The sinks copy them before returning, so
+   * {@link RTCOnDataEventDict} may borrow memory owned by JavaScript.
+   */
+  void PushData(const RTCOnDataEventDict& dict) {
+    if (!dict.numberOfFrames.IsJust()) {
+      return;
+    }
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (auto sink : _sinks) {
       sink->OnData(
-          dict.samples,
+          dict.samples.get(),
           dict.bitsPerSample,
           dict.sampleRate,
           dict.channelCount,
           dict.numberOfFrames.UnsafeFromJust()
       );
     }
-    // HACK(mroberts): I'd rather we use a smart pointer.
-    delete[] dict.samples;
   }
 
+  void PushFrame(const webrtc::AudioFrame& frame) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (auto sink : _sinks) {
+      sink->OnData(
+          frame.data(),
+          16,
+          frame.sample_rate_hz_,
+          frame.num_channels_,
+          frame.samples_per_channel_
+      );
+    }
+  }
+
+  // A track may be sent, sunk, and mixed at the same time, so every sink is
+  // kept, and removed by identity.
   void AddSink(webrtc::AudioTrackSinkInterface* sink) override {
-    _sink = sink;
+    std::lock_guard<std::mutex> lock(_mutex);
+    _sinks.insert(sink);
   }
 
-  void RemoveSink(webrtc::AudioTrackSinkInterface*) override {
-    _sink = nullptr;
+  void RemoveSink(webrtc::AudioTrackSinkInterface* sink) override {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _sinks.erase(sink);
   }
 
  private:
   PeerConnectionFactory* _factory = PeerConnectionFactory::GetOrCreateDefault();
 
-  std::atomic<webrtc::AudioTrackSinkInterface*> _sink = {nullptr};
+  std::mutex _mutex;
+  std::set<webrtc::AudioTrackSinkInterface*> _sinks;
 };
 
 class RTCAudioSource
@@ -36,7 +36,7 @@ RTCIceTransport::RTCIceTransport(const Napi::CallbackInfo& info)
 
   _transport = std::move(transport);
 
-  _factory->_workerThread->Invoke<void>(RTC_FROM_HERE, [this]() {
+  _factory->_networkThread->Invoke<void>(RTC_FROM_HERE, [this]() {
     auto internal = _transport->internal();
     if (internal) {
       internal->SignalIceTransportStateChanged.connect(this, &RTCIceTransport::OnStateChanged);
@@ -78,7 +78,7 @@ void RTCIceTransport::OnRTCDtlsTransportStopped() {
 }
 
 void RTCIceTransport::Stop() {
-  // _factory->_workerThread->Invoke<void>(RTC_FROM_HERE, [this]() {
+  // _factory->_networkThread->Invoke<void>(RTC_FROM_HERE, [this]() {
   //   _transport->internal()->SignalIceTransportStateChanged.disconnect(this);
   //   _transport->internal()->SignalGatheringState.disconnect(this);
   // });
@@ -8,13 +8,19 @@
 #include "src/interfaces/rtc_peer_connection.h"
 
 #include <iosfwd>
+#include <string>
+#include <utility>
 
+#include <absl/strings/ascii.h>
+#include <absl/strings/match.h>
 #include <webrtc/api/media_types.h>
 #include <webrtc/api/peer_connection_interface.h>
 #include <webrtc/api/rtc_error.h>
 #include <webrtc/api/rtp_transceiver_interface.h>
 #include <webrtc/api/scoped_refptr.h>
 #include <webrtc/p2p/client/basic_port_allocator.h>
+#include <webrtc/rtc_base/location.h>
+#include <webrtc/rtc_base/thread.h>
 
 #include "src/converters.h"
 #include "src/converters/arguments.h"
@@ -24,6 +30,9 @@
 #include "src/dictionaries/node_webrtc/rtc_answer_options.h"
 #include "src/dictionaries/node_webrtc/rtc_offer_options.h"
 #include "src/dictionaries/node_webrtc/rtc_session_description_init.h"
+#include "src/dictionaries/node_webrtc/rtc_stats_buffer.h"
+#include "src/dictionaries/node_webrtc/rtc_stats_filter.h"
+#include "src/dictionaries/node_webrtc/rtc_stats_subscription_options.h"
 #include "src/dictionaries/node_webrtc/some_error.h"
 #include "src/dictionaries/webrtc/data_channel_init.h"
 #include "src/dictionaries/webrtc/ice_candidate_interface.h"
@@ -40,11 +49,14 @@
 #include "src/interfaces/media_stream.h"
 #include "src/interfaces/media_stream_track.h"
 #include "src/interfaces/rtc_data_channel.h"
+#include "src/interfaces/rtc_peer_connection/batch_stats_collector.h"
 #include "src/interfaces/rtc_peer_connection/create_session_description_observer.h"
+#include "src/interfaces/rtc_peer_connection/ice_candidate_batcher.h"
 #include "src/interfaces/rtc_peer_connection/peer_connection_factory.h"
 #include "src/interfaces/rtc_peer_connection/rtc_stats_collector.h"
 #include "src/interfaces/rtc_peer_connection/set_session_description_observer.h"
 #include "src/interfaces/rtc_peer_connection/stats_observer.h"
+#include "src/interfaces/rtc_peer_connection/stats_subscription.h"
 #include "src/interfaces/rtc_rtp_receiver.h"
 #include "src/interfaces/rtc_rtp_sender.h"
 #include "src/interfaces/rtc_rtp_transceiver.h"
@@ -53,9 +65,32 @@
 #include "src/node/events.h"
 #include "src/node/promise.h"
 #include "src/node/utility.h"
+#include "src/webrtc/shared_udp_socket_factory.h"
 
 namespace node_webrtc {
 
+// Whether |servers| includes a TURN server reached over UDP. Relayed traffic
+// cannot be routed on a shared UDP port when several RTCPeerConnections use
+// the same TURN server, so these are refused with `sharedUdpPort`.
+static bool HasUdpTurnServer(const webrtc::PeerConnectionInterface::IceServers& servers) {
+  for (auto const& server : servers) {
+    auto urls = server.urls;
+    if (!server.uri.empty()) {
+      urls.push_back(server.uri);
+    }
+    for (auto url : urls) {
+      url = absl::AsciiStrToLower(url);
+      if (absl::StartsWith(url, "turn:") && !absl::StrContains(url, "transport=tcp")) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+static const char* kUdpTurnWithSharedUdpPort =
+    "TURN servers over UDP are not supported by RTCPeerConnectionFactories with a sharedUdpPort";
+
 Napi::FunctionReference& RTCPeerConnection::constructor() {
   static Napi::FunctionReference constructor;
   return constructor;
@@ -78,13 +113,28 @@ RTCPeerConnection::RTCPeerConnection(const Napi::CallbackInfo& info)
 
   auto configuration = maybeConfiguration.FromMaybe(ExtendedRTCConfiguration());
 
-  // TODO(mroberts): Read `factory` (non-standard) from RTCConfiguration?
-  _factory = PeerConnectionFactory::GetOrCreateDefault();
-  _shouldReleaseFactory = true;
+  if (configuration.factory.IsJust()) {
+    _factory = configuration.factory.UnsafeFromJust();
+    _factory->Ref();
+    _shouldReleaseFactory = false;
+  } else {
+    _factory = PeerConnectionFactory::GetOrCreateDefault();
+    _shouldReleaseFactory = true;
+  }
+  _factory->AddPeerConnection();
+
+  rtc::PacketSocketFactory* socketFactory = _factory->getSocketFactory();
+  _sharedUdpSocketFactory = _factory->CreateSharedUdpSocketFactory();
+  if (_sharedUdpSocketFactory) {
+    if (HasUdpTurnServer(configuration.configuration.servers)) {
+      ReleaseFactory();
+      Napi::Error(env, ErrorFactory::CreateInvalidAccessError(env, kUdpTurnWithSharedUdpPort)).ThrowAsJavaScriptException();
+      return;
+    }
+    socketFactory = _sharedUdpSocketFactory.get();
+  }
 
-  auto portAllocator = std::unique_ptr<cricket::PortAllocator>(new cricket::BasicPortAllocator(
-              _factory->getNetworkManager(),
-              _factory->getSocketFactory()));
+  auto portAllocator = _factory->CreatePortAllocator(socketFactory);
   _port_range = configuration.portRange;
   portAllocator->SetPortRange(
       _port_range.min.FromMaybe(0),
@@ -98,17 +148,52 @@ RTCPeerConnection::RTCPeerConnection(const Napi::CallbackInfo& info)
 }
 
 RTCPeerConnection::~RTCPeerConnection() {
+  StopStatsSubscription();
+  SetIceCandidateBatcher(nullptr);
   _jinglePeerConnection = nullptr;
   _channels.clear();
+  ReleaseFactory();
+}
+
+void RTCPeerConnection::ReleaseFactory() {
+  // The SharedUdpSocketFactory refers to the factory's shared UDP sockets.
+  _sharedUdpSocketFactory = nullptr;
   if (_factory) {
+    _factory->RemovePeerConnection();
     if (_shouldReleaseFactory) {
       PeerConnectionFactory::Release();
+    } else {
+      Napi::HandleScope scope(PeerConnectionFactory::constructor().Env());
+      _factory->Unref();
     }
     _factory = nullptr;
   }
 }
 
+void RTCPeerConnection::StopStatsSubscription() {
+  if (_statsSubscription) {
+    _statsSubscription->Stop();
+    _statsSubscription = nullptr;
+  }
+}
+
+void RTCPeerConnection::SetIceCandidateBatcher(std::unique_ptr<IceCandidateBatcher> batcher) {
+  // Skip the hop to the signaling thread when there is nothing to replace.
+  if (!_factory || (!batcher && !_batchingIceCandidates)) {
+    return;
+  }
+  _batchingIceCandidates = batcher != nullptr;
+  _factory->_signalingThread->Invoke<void>(RTC_FROM_HERE, [this, &batcher]() {
+    // Deliver whatever the old batcher was holding before replacing it.
+    if (_iceCandidateBatcher) {
+      _iceCandidateBatcher->Flush(false);
+    }
+    _iceCandidateBatcher = std::move(batcher);
+  });
+}
+
 void RTCPeerConnection::OnSignalingChange(webrtc::PeerConnectionInterface::SignalingState state) {
+  InvalidateCachedDescriptions();
   Dispatch(CreateCallback<RTCPeerConnection>([this, state]() {
     MakeCallback("onsignalingstatechange", {});
     if (state == webrtc::PeerConnectionInterface::kClosed) {
@@ -124,41 +209,59 @@ void RTCPeerConnection::OnIceConnectionChange(webrtc::PeerConnectionInterface::I
   }));
 }
 
-void RTCPeerConnection::OnIceGatheringChange(webrtc::PeerConnectionInterface::IceGatheringState) {
+void RTCPeerConnection::OnIceGatheringChange(webrtc::PeerConnectionInterface::IceGatheringState state) {
+  // The last batch doubles as the end-of-candidates signal.
+  if (_iceCandidateBatcher && state == webrtc::PeerConnectionInterface::kIceGatheringComplete) {
+    _iceCandidateBatcher->Flush(true);
+  }
   Dispatch(CreateCallback<RTCPeerConnection>([this]() {
     MakeCallback("onicegatheringstatechange", {});
   }));
 }
 
 void RTCPeerConnection::OnIceCandidate(const webrtc::IceCandidateInterface* ice_candidate) {
-  std::string error;
+  // The candidate has been added to the local description.
+  InvalidateCachedDescriptions();
 
-  std::string sdp;
-  if (!ice_candidate->ToString(&sdp)) {
-    error = "Failed to print the candidate string. This is pretty weird. File a bug on https://github.com/node-webrtc/node-webrtc";
-    return;
+  // The remote peer may start sending connectivity checks as soon as it learns
+  // of this candidate, so tell the shared UDP sockets where to route them now.
+  if (_sharedUdpSocketFactory) {
+    _sharedUdpSocketFactory->AddUsernameFragment(ice_candidate->candidate().username());
   }
 
-  webrtc::SdpParseError parseError;
+  // |ice_candidate| is only valid for the duration of this call.
   auto candidate = std::shared_ptr<webrtc::IceCandidateInterface>(webrtc::CreateIceCandidate(
               ice_candidate->sdp_mid(),
               ice_candidate->sdp_mline_index(),
-              sdp,
-              &parseError));
-  if (!parseError.description.empty()) {
-    error = parseError.description;
-  } else if (!candidate) {
-    error = "Failed to copy RTCIceCandidate";
+              ice_candidate->candidate()));
+
+  if (_iceCandidateBatcher) {
+    _iceCandidateBatcher->Add(std::move(candidate));
+    return;
   }
 
-  Dispatch(CreateCallback<RTCPeerConnection>([this, candidate, error]() {
-    if (error.empty()) {
-      auto env = Env();
+  Dispatch(CreateCallback<RTCPeerConnection>([this, candidate]() {
+    auto env = Env();
+    auto maybeCandidate = From<Napi::Value>(std::make_pair(env, candidate.get()));
+    if (maybeCandidate.IsValid()) {
+      MakeCallback("onicecandidate", { maybeCandidate.UnsafeFromValid() });
+    }
+  }));
+}
+
+void RTCPeerConnection::OnIceCandidates(std::vector<std::shared_ptr<webrtc::IceCandidateInterface>> candidates, bool complete) {
+  Dispatch(CreateCallback<RTCPeerConnection>([this, candidates, complete]() {
+    auto env = Env();
+    auto array = Napi::Array::New(env);
+    uint32_t i = 0;
+    for (auto const& candidate : candidates) {
+      // Skip a candidate that fails to convert, rather than the whole batch.
       auto maybeCandidate = From<Napi::Value>(std::make_pair(env, candidate.get()));
       if (maybeCandidate.IsValid()) {
-        MakeCallback("onicecandidate", { maybeCandidate.UnsafeFromValid() });
+        array.Set(i++, maybeCandidate.UnsafeFromValid());
       }
     }
+    MakeCallback("onicecandidates", { array, Napi::Boolean::New(env, complete) });
   }));
 }
 
@@ -191,6 +294,10 @@ void RTCPeerConnection::OnIceCandidateError(const std::string& host_candidate, c
   }));
 }
 
+void RTCPeerConnection::OnIceCandidatesRemoved(const std::vector<cricket::Candidate>&) {
+  InvalidateCachedDescriptions();
+}
+
 void RTCPeerConnection::OnDataChannel(rtc::scoped_refptr<webrtc::DataChannelInterface> channel) {
   auto observer = new DataChannelObserver(_factory, channel);
   Dispatch(CreateCallback<RTCPeerConnection>([this, observer]() {
@@ -214,8 +321,10 @@ void RTCPeerConnection::OnAddTrack(rtc::scoped_refptr<webrtc::RtpReceiverInterfa
       mediaStreams.push_back(mediaStream);
     }
     CONVERT_OR_THROW_AND_RETURN_VOID_NAPI(Env(), mediaStreams, streamArray, Napi::Value)
+    auto rtpReceiver = RTCRtpReceiver::wrap()->GetOrCreate(_factory, receiver);
+    rtpReceiver->SetPeerConnection(Value());
     MakeCallback("ontrack", {
-      RTCRtpReceiver::wrap()->GetOrCreate(_factory, receiver)->Value(),
+      rtpReceiver->Value(),
       streamArray,
       Env().Null()
     });
@@ -232,10 +341,14 @@ void RTCPeerConnection::OnTrack(rtc::scoped_refptr<webrtc::RtpTransceiverInterfa
       mediaStreams.push_back(mediaStream);
     }
     CONVERT_OR_THROW_AND_RETURN_VOID_NAPI(Env(), mediaStreams, streamArray, Napi::Value)
+    auto rtpReceiver = RTCRtpReceiver::wrap()->GetOrCreate(_factory, receiver);
+    rtpReceiver->SetPeerConnection(Value());
+    auto rtpTransceiver = RTCRtpTransceiver::wrap()->GetOrCreate(_factory, transceiver);
+    rtpTransceiver->SetPeerConnection(Value());
     MakeCallback("ontrack", {
-      RTCRtpReceiver::wrap()->GetOrCreate(_factory, receiver)->Value(),
+      rtpReceiver->Value(),
       streamArray,
-      RTCRtpTransceiver::wrap()->GetOrCreate(_factory, transceiver)->Value()
+      rtpTransceiver->Value()
     });
   }));
 }
@@ -271,8 +384,9 @@ Napi::Value RTCPeerConnection::AddTrack(const Napi::CallbackInfo& info) {
     Napi::Error(env, error).ThrowAsJavaScriptException();
     return env.Undefined();
   }
-  auto rtpSender = result.value();
-  return RTCRtpSender::wrap()->GetOrCreate(_factory, rtpSender)->Value();
+  auto rtpSender = RTCRtpSender::wrap()->GetOrCreate(_factory, result.value());
+  rtpSender->SetPeerConnection(Value());
+  return rtpSender->Value();
 }
 
 Napi::Value RTCPeerConnection::AddTransceiver(const Napi::CallbackInfo& info) {
@@ -299,8 +413,9 @@ Napi::Value RTCPeerConnection::AddTransceiver(const Napi::CallbackInfo& info) {
     Napi::Error(env, error).ThrowAsJavaScriptException();
     return env.Undefined();
   }
-  auto rtpTransceiver = result.value();
-  return RTCRtpTransceiver::wrap()->GetOrCreate(_factory, rtpTransceiver)->Value();
+  auto rtpTransceiver = RTCRtpTransceiver::wrap()->GetOrCreate(_factory, result.value());
+  rtpTransceiver->SetPeerConnection(Value());
+  return rtpTransceiver->Value();
 }
 
 Napi::Value RTCPeerConnection::RemoveTrack(const Napi::CallbackInfo& info) {
@@ -341,8 +456,9 @@ Napi::Value RTCPeerConnection::CreateOffer(const Napi::CallbackInfo& info) {
     return deferred.Promise();
   }
 
-  auto observer = new rtc::RefCountedObject<CreateSessionDescriptionObserver>(this, deferred);
-  _jinglePeerConnection->CreateOffer(observer, maybeOptions.UnsafeFromValid().options);
+  auto options = maybeOptions.UnsafeFromValid();
+  auto observer = new rtc::RefCountedObject<CreateSessionDescriptionObserver>(this, deferred, options.sdpEdits);
+  _jinglePeerConnection->CreateOffer(observer, options.options);
 
   return deferred.Promise();
 }
@@ -366,8 +482,9 @@ Napi::Value RTCPeerConnection::CreateAnswer(const Napi::CallbackInfo& info) {
     return deferred.Promise();
   }
 
-  auto observer = new rtc::RefCountedObject<CreateSessionDescriptionObserver>(this, deferred);
-  _jinglePeerConnection->CreateAnswer(observer, maybeOptions.UnsafeFromValid().options);
+  auto options = maybeOptions.UnsafeFromValid();
+  auto observer = new rtc::RefCountedObject<CreateSessionDescriptionObserver>(this, deferred, options.sdpEdits);
+  _jinglePeerConnection->CreateAnswer(observer, options.options);
 
   return deferred.Promise();
 }
@@ -377,17 +494,28 @@ Napi::Value RTCPeerConnection::SetLocalDescription(const Napi::CallbackInfo& inf
   CREATE_DEFERRED(env, deferred)
 
   CONVERT_ARGS_OR_REJECT_AND_RETURN_NAPI(deferred, info, descriptionInit, RTCSessionDescriptionInit)
-  if (descriptionInit.sdp.empty()) {
-    descriptionInit.sdp = _lastSdp.sdp;
+
+  // The description createOffer or createAnswer last created is already
+  // parsed (and edited); only SDP changed in JavaScript needs parsing.
+  std::unique_ptr<webrtc::SessionDescriptionInterface> description;
+  {
+    std::lock_guard<std::mutex> lock(_lastSdpMutex);
+    if (descriptionInit.sdp.empty()) {
+      descriptionInit.sdp = _lastSdp.sdp;
+    }
+    if (_lastDescription && descriptionInit.type == _lastSdp.type && descriptionInit.sdp == _lastSdp.sdp) {
+      description = std::move(_lastDescription);
+    }
   }
 
-  auto maybeRawDescription = From<webrtc::SessionDescriptionInterface*>(descriptionInit);
-  if (maybeRawDescription.IsInvalid()) {
-    Reject(deferred, maybeRawDescription.ToErrors()[0]);
-    return deferred.Promise();
+  if (!description) {
+    auto maybeRawDescription = From<webrtc::SessionDescriptionInterface*>(descriptionInit);
+    if (maybeRawDescription.IsInvalid()) {
+      Reject(deferred, maybeRawDescription.ToErrors()[0]);
+      return deferred.Promise();
+    }
+    description.reset(maybeRawDescription.UnsafeFromValid());
   }
-  auto rawDescription = maybeRawDescription.UnsafeFromValid();
-  std::unique_ptr<webrtc::SessionDescriptionInterface> description(rawDescription);
 
   if (!_jinglePeerConnection || _jinglePeerConnection->signaling_state() == webrtc::PeerConnectionInterface::SignalingState::kClosed) {
     Reject(deferred, ErrorFactory::CreateInvalidStateError(env,
@@ -432,6 +560,7 @@ Napi::Value RTCPeerConnection::AddIceCandidate(const Napi::CallbackInfo& info) {
     if (_jinglePeerConnection
         && _jinglePeerConnection->signaling_state() != webrtc::PeerConnectionInterface::SignalingState::kClosed
         && _jinglePeerConnection->AddIceCandidate(candidate.get())) {
+      InvalidateCachedDescriptions();
       Resolve(deferred, this->Env().Undefined());
     } else {
       std::string error = std::string("Failed to set ICE candidate");
@@ -447,6 +576,47 @@ Napi::Value RTCPeerConnection::AddIceCandidate(const Napi::CallbackInfo& info) {
   return deferred.Promise();
 }
 
+Napi::Value RTCPeerConnection::AddIceCandidates(const Napi::CallbackInfo& info) {
+  auto env = info.Env();
+  CREATE_DEFERRED(env, deferred)
+
+  CONVERT_ARGS_OR_REJECT_AND_RETURN_NAPI(deferred, info, candidates, std::vector<std::shared_ptr<webrtc::IceCandidateInterface>>)
+
+  Dispatch(CreatePromise<RTCPeerConnection>(deferred, [this, candidates](auto deferred) {
+    if (!_jinglePeerConnection
+        || _jinglePeerConnection->signaling_state() == webrtc::PeerConnectionInterface::SignalingState::kClosed) {
+      Reject(deferred, SomeError("Failed to set ICE candidates; RTCPeerConnection is closed."));
+      return;
+    }
+
+    // Add every candidate in a single task, rather than blocking on the
+    // signaling thread once per candidate.
+    std::vector<size_t> failed;
+    auto peerConnection = _jinglePeerConnection;
+    _factory->_signalingThread->Invoke<void>(RTC_FROM_HERE, [&candidates, &failed, &peerConnection]() {
+      for (size_t i = 0; i < candidates.size(); i++) {
+        if (!peerConnection->AddIceCandidate(candidates[i].get())) {
+          failed.push_back(i);
+        }
+      }
+    });
+    InvalidateCachedDescriptions();
+
+    if (failed.empty()) {
+      Resolve(deferred, this->Env().Undefined());
+      return;
+    }
+    std::string error = "Failed to set ICE candidates at indices";
+    for (auto i : failed) {
+      error += (i == failed.front() ? " " : ", ") + std::to_string(i);
+    }
+    error += ".";
+    Reject(deferred, SomeError(error));
+  }));
+
+  return deferred.Promise();
+}
+
 Napi::Value RTCPeerConnection::CreateDataChannel(const Napi::CallbackInfo& info) {
   auto env = info.Env();
   if (_jinglePeerConnection == nullptr) {
@@ -477,8 +647,13 @@ Napi::Value RTCPeerConnection::CreateDataChannel(const Napi::CallbackInfo& info)
 }
 
 Napi::Value RTCPeerConnection::GetConfiguration(const Napi::CallbackInfo& info) {
+  // Only a factory passed to the constructor is reported, and only until
+  // close, which releases it.
   auto configuration = _jinglePeerConnection
-      ? ExtendedRTCConfiguration(_jinglePeerConnection->GetConfiguration(), _port_range)
+      ? ExtendedRTCConfiguration(
+          _jinglePeerConnection->GetConfiguration(),
+          _port_range,
+          _shouldReleaseFactory ? MakeNothing<PeerConnectionFactory*>() : MakeJust(_factory))
       : _cached_configuration;
   CONVERT_OR_THROW_AND_RETURN_NAPI(info.Env(), configuration, result, Napi::Value)
   return result;
@@ -494,6 +669,11 @@ Napi::Value RTCPeerConnection::SetConfiguration(const Napi::CallbackInfo& info)
     return env.Undefined();
   }
 
+  if (_sharedUdpSocketFactory && HasUdpTurnServer(configuration.servers)) {
+    Napi::Error(env, ErrorFactory::CreateInvalidAccessError(env, kUdpTurnWithSharedUdpPort)).ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
   auto rtcError = _jinglePeerConnection->SetConfiguration(configuration);
   if (!rtcError.ok()) {
     CONVERT_OR_THROW_AND_RETURN_NAPI(env, &rtcError, error, Napi::Value)
@@ -508,7 +688,9 @@ Napi::Value RTCPeerConnection::GetReceivers(const Napi::CallbackInfo& info) {
   std::vector<RTCRtpReceiver*> receivers;
   if (_jinglePeerConnection) {
     for (const auto& receiver : _jinglePeerConnection->GetReceivers()) {
-      receivers.emplace_back(RTCRtpReceiver::wrap()->GetOrCreate(_factory, receiver));
+      auto rtpReceiver = RTCRtpReceiver::wrap()->GetOrCreate(_factory, receiver);
+      rtpReceiver->SetPeerConnection(Value());
+      receivers.emplace_back(rtpReceiver);
     }
   }
   CONVERT_OR_THROW_AND_RETURN_NAPI(info.Env(), receivers, result, Napi::Value)
@@ -519,7 +701,9 @@ Napi::Value RTCPeerConnection::GetSenders(const Napi::CallbackInfo& info) {
   std::vector<RTCRtpSender*> senders;
   if (_jinglePeerConnection) {
     for (const auto& sender : _jinglePeerConnection->GetSenders()) {
-      senders.emplace_back(RTCRtpSender::wrap()->GetOrCreate(_factory, sender));
+      auto rtpSender = RTCRtpSender::wrap()->GetOrCreate(_factory, sender);
+      rtpSender->SetPeerConnection(Value());
+      senders.emplace_back(rtpSender);
     }
   }
   CONVERT_OR_THROW_AND_RETURN_NAPI(info.Env(), senders, result, Napi::Value)
@@ -531,28 +715,168 @@ Napi::Value RTCPeerConnection::GetStats(const Napi::CallbackInfo& info) {
 
   CREATE_DEFERRED(env, deferred)
 
+  CONVERT_ARGS_OR_REJECT_AND_RETURN_NAPI(deferred, info, maybeFilter, Maybe<RTCStatsFilter>)
+  auto filter = maybeFilter.Map([](auto filter) {
+    return std::make_shared<const RTCStatsFilter>(filter);
+  }).FromMaybe(nullptr);
+
   if (!_jinglePeerConnection) {
     Reject(deferred, ErrorFactory::CreateError(env, "RTCPeerConnection is closed"));
     return deferred.Promise();
   }
 
-  auto callback = new rtc::RefCountedObject<RTCStatsCollector>(this, deferred);
+  auto callback = new rtc::RefCountedObject<RTCStatsCollector>(this, deferred, filter);
   _jinglePeerConnection->GetStats(callback);
 
   return deferred.Promise();  // NOLINT
 }
 
+void RTCPeerConnection::GetSelectedStats(
+    Napi::Promise::Deferred deferred,
+    rtc::scoped_refptr<webrtc::RtpSenderInterface> sender,
+    std::shared_ptr<const RTCStatsFilter> filter) {
+  if (!_jinglePeerConnection) {
+    Reject(deferred, ErrorFactory::CreateError(Env(), "RTCPeerConnection is closed"));
+    return;
+  }
+
+  auto callback = new rtc::RefCountedObject<RTCStatsCollector>(this, deferred, std::move(filter));
+  _jinglePeerConnection->GetStats(sender, callback);
+}
+
+void RTCPeerConnection::GetSelectedStats(
+    Napi::Promise::Deferred deferred,
+    rtc::scoped_refptr<webrtc::RtpReceiverInterface> receiver,
+    std::shared_ptr<const RTCStatsFilter> filter) {
+  if (!_jinglePeerConnection) {
+    Reject(deferred, ErrorFactory::CreateError(Env(), "RTCPeerConnection is closed"));
+    return;
+  }
+
+  auto callback = new rtc::RefCountedObject<RTCStatsCollector>(this, deferred, std::move(filter));
+  _jinglePeerConnection->GetStats(receiver, callback);
+}
+
+Napi::Value RTCPeerConnection::GetStatsBuffer(const Napi::CallbackInfo& info) {
+  auto env = info.Env();
+
+  CREATE_DEFERRED(env, deferred)
+
+  CONVERT_ARGS_OR_REJECT_AND_RETURN_NAPI(deferred, info, maybeFilter, Maybe<RTCStatsFilter>)
+  auto filter = maybeFilter.Map([](auto filter) {
+    return std::make_shared<const RTCStatsFilter>(filter);
+  }).FromMaybe(nullptr);
+
+  if (!_jinglePeerConnection) {
+    Reject(deferred, ErrorFactory::CreateError(env, "RTCPeerConnection is closed"));
+    return deferred.Promise();
+  }
+
+  auto callback = new rtc::RefCountedObject<RTCStatsBufferCollector>(this, deferred, filter);
+  _jinglePeerConnection->GetStats(callback);
+
+  return deferred.Promise();  // NOLINT
+}
+
+Napi::Value RTCPeerConnection::CollectStats(const Napi::CallbackInfo& info) {
+  auto env = info.Env();
+
+  CREATE_DEFERRED(env, deferred)
+
+  CONVERT_ARGS_OR_REJECT_AND_RETURN_NAPI(deferred, info, args, std::tuple<std::vector<RTCPeerConnection*> COMMA Maybe<RTCStatsFilter>>)
+  auto filter = std::get<1>(args).Map([](auto filter) {
+    return std::make_shared<const RTCStatsFilter>(filter);
+  }).FromMaybe(nullptr);
+
+  std::vector<BatchStatsCollector::Connection> connections;
+  connections.reserve(std::get<0>(args).size());
+  for (auto peerConnection : std::get<0>(args)) {
+    connections.push_back({
+      peerConnection->_factory ? peerConnection->_factory->_signalingThread.get() : nullptr,
+      peerConnection->_jinglePeerConnection
+    });
+  }
+  BatchStatsCollector::Collect(env, deferred, connections, filter);
+
+  return deferred.Promise();
+}
+
+Napi::Value RTCPeerConnection::SubscribeStats(const Napi::CallbackInfo& info) {
+  auto env = info.Env();
+  if (_jinglePeerConnection == nullptr) {
+    Napi::Error(env, ErrorFactory::CreateInvalidStateError(env,
+            "Failed to execute 'subscribeStats' on 'RTCPeerConnection': "
+            "The RTCPeerConnection's signalingState is 'closed'.")).ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  CONVERT_ARGS_OR_THROW_AND_RETURN_NAPI(info, maybeOptions, Maybe<RTCStatsSubscriptionOptions>)
+
+  StopStatsSubscription();
+  _statsSubscription = new rtc::RefCountedObject<StatsSubscription>(
+      this,
+      _factory->_signalingThread.get(),
+      _jinglePeerConnection,
+      maybeOptions.FromMaybe(RTCStatsSubscriptionOptions()));
+  _statsSubscription->Start();
+
+  return env.Undefined();
+}
+
+Napi::Value RTCPeerConnection::UnsubscribeStats(const Napi::CallbackInfo& info) {
+  StopStatsSubscription();
+  return info.Env().Undefined();
+}
+
+Napi::Value RTCPeerConnection::BatchIceCandidates(const Napi::CallbackInfo& info) {
+  auto env = info.Env();
+  if (_jinglePeerConnection == nullptr) {
+    Napi::Error(env, ErrorFactory::CreateInvalidStateError(env,
+            "Failed to execute 'batchIceCandidates' on 'RTCPeerConnection': "
+            "The RTCPeerConnection's signalingState is 'closed'.")).ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  CONVERT_ARGS_OR_THROW_AND_RETURN_NAPI(info, maybeWindowMs, Maybe<uint32_t>)
+
+  SetIceCandidateBatcher(std::unique_ptr<IceCandidateBatcher>(new IceCandidateBatcher(
+              this,
+              _factory->_signalingThread.get(),
+              maybeWindowMs.FromMaybe(IceCandidateBatcher::kDefaultWindowMs))));
+
+  return env.Undefined();
+}
+
+Napi::Value RTCPeerConnection::UnbatchIceCandidates(const Napi::CallbackInfo& info) {
+  SetIceCandidateBatcher(nullptr);
+  return info.Env().Undefined();
+}
+
+void RTCPeerConnection::OnStats(RTCStatsBuffer delta) {
+  Dispatch(CreateCallback<RTCPeerConnection>([this, delta]() {
+    auto env = Env();
+    auto maybeDelta = From<Napi::Value>(std::make_pair(env, delta));
+    if (maybeDelta.IsValid()) {
+      MakeCallback("onstats", { maybeDelta.UnsafeFromValid() });
+    }
+  }));
+}
+
 Napi::Value RTCPeerConnection::LegacyGetStats(const Napi::CallbackInfo& info) {
   auto env = info.Env();
 
   CREATE_DEFERRED(env, deferred)
 
+  CONVERT_ARGS_OR_REJECT_AND_RETURN_NAPI(deferred, info, maybeFlat, Maybe<bool>)
+
   if (!_jinglePeerConnection) {
     Reject(deferred, Napi::Error::New(env, "RTCPeerConnection is closed"));
     return deferred.Promise();
   }
 
-  auto statsObserver = new rtc::RefCountedObject<StatsObserver>(this, deferred);
+  auto statsObserver = maybeFlat.FromMaybe(false)
+      ? static_cast<webrtc::StatsObserver*>(new rtc::RefCountedObject<FlatStatsObserver>(this, deferred))
+      : static_cast<webrtc::StatsObserver*>(new rtc::RefCountedObject<StatsObserver>(this, deferred));
   if (!_jinglePeerConnection->GetStats(statsObserver, nullptr,
           webrtc::PeerConnectionInterface::kStatsOutputLevelStandard)) {
     Reject(deferred, Napi::Error::New(env, "Failed to execute getStats"));
@@ -567,7 +891,9 @@ Napi::Value RTCPeerConnection::GetTransceivers(const Napi::CallbackInfo& info) {
   if (_jinglePeerConnection
       && _jinglePeerConnection->GetConfiguration().sdp_semantics == webrtc::SdpSemantics::kUnifiedPlan) {
     for (const auto& transceiver : _jinglePeerConnection->GetTransceivers()) {
-      transceivers.emplace_back(RTCRtpTransceiver::wrap()->GetOrCreate(_factory, transceiver));
+      auto rtpTransceiver = RTCRtpTransceiver::wrap()->GetOrCreate(_factory, transceiver);
+      rtpTransceiver->SetPeerConnection(Value());
+      transceivers.emplace_back(rtpTransceiver);
     }
   }
   CONVERT_OR_THROW_AND_RETURN_NAPI(info.Env(), transceivers, result, Napi::Value)
@@ -597,14 +923,11 @@ Napi::Value RTCPeerConnection::Close(const Napi::CallbackInfo& info) {
     }
   }
 
+  StopStatsSubscription();
+  SetIceCandidateBatcher(nullptr);
   _jinglePeerConnection = nullptr;
 
-  if (_factory) {
-    if (_shouldReleaseFactory) {
-      PeerConnectionFactory::Release();
-    }
-    _factory = nullptr;
-  }
+  ReleaseFactory();
 
   return info.Env().Undefined();
 }
@@ -632,64 +955,65 @@ Napi::Value RTCPeerConnection::GetConnectionState(const Napi::CallbackInfo& info
   return result;
 }
 
-Napi::Value RTCPeerConnection::GetCurrentLocalDescription(const Napi::CallbackInfo& info) {
-  auto env = info.Env();
-  Napi::Value result = env.Null();
-  if (_jinglePeerConnection && _jinglePeerConnection->current_local_description()) {
-    CONVERT_OR_THROW_AND_RETURN_NAPI(env, _jinglePeerConnection->current_local_description(), description, Napi::Value)
-    result = description;
+void RTCPeerConnection::InvalidateCachedDescriptions() {
+  _descriptionsVersion++;
+}
+
+Napi::Value RTCPeerConnection::GetCachedDescription(Napi::Env env, const webrtc::SessionDescriptionInterface* description) {
+  if (!description) {
+    return env.Null();
   }
-  return result;
+
+  auto version = _descriptionsVersion.load();
+  if (version != _cachedDescriptionsVersion) {
+    _cachedDescriptions.clear();
+    _cachedDescriptionsVersion = version;
+  }
+
+  auto cached = _cachedDescriptions.find(description);
+  if (cached == _cachedDescriptions.end()) {
+    auto maybeInit = From<RTCSessionDescriptionInit>(description);
+    if (maybeInit.IsInvalid()) {
+      Napi::TypeError::New(env, maybeInit.ToErrors()[0]).ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+    auto init = maybeInit.UnsafeFromValid();
+    cached = _cachedDescriptions.emplace(description, CachedDescription {
+      init.type,
+      Napi::Persistent(Napi::String::New(env, init.sdp))
+    }).first;
+  }
+
+  Napi::EscapableHandleScope scope(env);
+  auto object = Napi::Object::New(env);
+  CONVERT_OR_THROW_AND_RETURN_NAPI(env, cached->second.type, type, Napi::Value)
+  object.Set("type", type);
+  object.Set("sdp", cached->second.sdp.Value());
+  return scope.Escape(object);
+}
+
+Napi::Value RTCPeerConnection::GetCurrentLocalDescription(const Napi::CallbackInfo& info) {
+  return GetCachedDescription(info.Env(), _jinglePeerConnection ? _jinglePeerConnection->current_local_description() : nullptr);
 }
 
 Napi::Value RTCPeerConnection::GetLocalDescription(const Napi::CallbackInfo& info) {
-  auto env = info.Env();
-  Napi::Value result = env.Null();
-  if (_jinglePeerConnection && _jinglePeerConnection->local_description()) {
-    CONVERT_OR_THROW_AND_RETURN_NAPI(env, _jinglePeerConnection->local_description(), description, Napi::Value)
-    result = description;
-  }
-  return result;
+  return GetCachedDescription(info.Env(), _jinglePeerConnection ? _jinglePeerConnection->local_description() : nullptr);
 }
 
 Napi::Value RTCPeerConnection::GetPendingLocalDescription(const Napi::CallbackInfo& info) {
-  auto env = info.Env();
-  Napi::Value result = env.Null();
-  if (_jinglePeerConnection && _jinglePeerConnection->pending_local_description()) {
-    CONVERT_OR_THROW_AND_RETURN_NAPI(env, _jinglePeerConnection->pending_local_description(), description, Napi::Value)
-    result = description;
-  }
-  return result;
+  return GetCachedDescription(info.Env(), _jinglePeerConnection ? _jinglePeerConnection->pending_local_description() : nullptr);
 }
 
 Napi::Value RTCPeerConnection::GetCurrentRemoteDescription(const Napi::CallbackInfo& info) {
-  auto env = info.Env();
-  Napi::Value result = env.Null();
-  if (_jinglePeerConnection && _jinglePeerConnection->current_remote_description()) {
-    CONVERT_OR_THROW_AND_RETURN_NAPI(env, _jinglePeerConnection->current_remote_description(), description, Napi::Value)
-    result = description;
-  }
-  return result;
+  return GetCachedDescription(info.Env(), _jinglePeerConnection ? _jinglePeerConnection->current_remote_description() : nullptr);
 }
 
 Napi::Value RTCPeerConnection::GetRemoteDescription(const Napi::CallbackInfo& info) {
-  auto env = info.Env();
-  Napi::Value result = env.Null();
-  if (_jinglePeerConnection && _jinglePeerConnection->remote_description()) {
-    CONVERT_OR_THROW_AND_RETURN_NAPI(env, _jinglePeerConnection->remote_description(), description, Napi::Value)
-    result = description;
-  }
-  return result;
+  return GetCachedDescription(info.Env(), _jinglePeerConnection ? _jinglePeerConnection->remote_description() : nullptr);
 }
 
 Napi::Value RTCPeerConnection::GetPendingRemoteDescription(const Napi::CallbackInfo& info) {
-  auto env = info.Env();
-  Napi::Value result = env.Null();
-  if (_jinglePeerConnection && _jinglePeerConnection->pending_remote_description()) {
-    CONVERT_OR_THROW_AND_RETURN_NAPI(env, _jinglePeerConnection->pending_remote_description(), description, Napi::Value)
-    result = description;
-  }
-  return result;
+  return GetCachedDescription(info.Env(), _jinglePeerConnection ? _jinglePeerConnection->pending_remote_description() : nullptr);
 }
 
 Napi::Value RTCPeerConnection::GetSctp(const Napi::CallbackInfo& info) {
@@ -722,8 +1046,12 @@ Napi::Value RTCPeerConnection::GetIceGatheringState(const Napi::CallbackInfo& in
   return result;
 }
 
-void RTCPeerConnection::SaveLastSdp(const RTCSessionDescriptionInit& lastSdp) {
+void RTCPeerConnection::SaveLastSdp(
+    const RTCSessionDescriptionInit& lastSdp,
+    std::unique_ptr<webrtc::SessionDescriptionInterface> lastDescription) {
+  std::lock_guard<std::mutex> lock(_lastSdpMutex);
   this->_lastSdp = lastSdp;
+  this->_lastDescription = std::move(lastDescription);
 }
 
 void RTCPeerConnection::Init(Napi::Env env, Napi::Object exports) {
@@ -741,10 +1069,16 @@ void RTCPeerConnection::Init(Napi::Env env, Napi::Object exports) {
     InstanceMethod("getReceivers", &RTCPeerConnection::GetReceivers),
     InstanceMethod("getSenders", &RTCPeerConnection::GetSenders),
     InstanceMethod("getStats", &RTCPeerConnection::GetStats),
+    InstanceMethod("getStatsBuffer", &RTCPeerConnection::GetStatsBuffer),
     InstanceMethod("legacyGetStats", &RTCPeerConnection::LegacyGetStats),
+    InstanceMethod("subscribeStats", &RTCPeerConnection::SubscribeStats),
+    InstanceMethod("unsubscribeStats", &RTCPeerConnection::UnsubscribeStats),
+    InstanceMethod("batchIceCandidates", &RTCPeerConnection::BatchIceCandidates),
+    InstanceMethod("unbatchIceCandidates", &RTCPeerConnection::UnbatchIceCandidates),
     InstanceMethod("getTransceivers", &RTCPeerConnection::GetTransceivers),
     InstanceMethod("updateIce", &RTCPeerConnection::UpdateIce),
     InstanceMethod("addIceCandidate", &RTCPeerConnection::AddIceCandidate),
+    InstanceMethod("addIceCandidates", &RTCPeerConnection::AddIceCandidates),
     InstanceMethod("createDataChannel", &RTCPeerConnection::CreateDataChannel),
     InstanceMethod("close", &RTCPeerConnection::Close),
     InstanceAccessor("canTrickleIceCandidates", &RTCPeerConnection::GetCanTrickleIceCandidates, nullptr),
@@ -758,7 +1092,8 @@ void RTCPeerConnection::Init(Napi::Env env, Napi::Object exports) {
     InstanceAccessor("sctp", &RTCPeerConnection::GetSctp, nullptr),
     InstanceAccessor("signalingState", &RTCPeerConnection::GetSignalingState, nullptr),
     InstanceAccessor("iceConnectionState", &RTCPeerConnection::GetIceConnectionState, nullptr),
-    InstanceAccessor("iceGatheringState", &RTCPeerConnection::GetIceGatheringState, nullptr)
+    InstanceAccessor("iceGatheringState", &RTCPeerConnection::GetIceGatheringState, nullptr),
+    StaticMethod("collectStats", &RTCPeerConnection::CollectStats)
   });
 
   constructor() = Napi::Persistent(func);
@@ -767,4 +1102,6 @@ void RTCPeerConnection::Init(Napi::Env env, Napi::Object exports) {
   exports.Set("RTCPeerConnection", func);
 }
 
+CONVERT_INTERFACE_FROM_NAPI(RTCPeerConnection, "RTCPeerConnection")
+
 }  // namespace node_webrtc
@@ -7,12 +7,18 @@
  */
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 
 #include <node-addon-api/napi.h>
 #include <webrtc/api/peer_connection_interface.h>
 #include <webrtc/api/scoped_refptr.h>
 
+#include "src/converters/napi.h"
 #include "src/node/async_object_wrap_with_loop.h"
 #include "src/dictionaries/node_webrtc/extended_rtc_configuration.h"
 #include "src/dictionaries/node_webrtc/rtc_session_description_init.h"
@@ -23,14 +29,20 @@ class DataChannelInterface;
 class IceCandidateInterface;
 class MediaStreamInterface;
 class RtpReceiverInterface;
+class RtpSenderInterface;
 class RtpTransceiverInterface;
 
 }  // namespace webrtc
 
 namespace node_webrtc {
 
+class IceCandidateBatcher;
 class RTCDataChannel;
 class PeerConnectionFactory;
+class SharedUdpSocketFactory;
+class StatsSubscription;
+struct RTCStatsBuffer;
+struct RTCStatsFilter;
 
 class RTCPeerConnection
   : public AsyncObjectWrapWithLoop<RTCPeerConnection>
@@ -48,6 +60,7 @@ class RTCPeerConnection
   void OnIceGatheringChange(webrtc::PeerConnectionInterface::IceGatheringState new_state) override;
   void OnIceCandidate(const webrtc::IceCandidateInterface* candidate) override;
   void OnIceCandidateError(const std::string& host_candidate, const std::string& url, int error_code, const std::string& error_text) override;
+  void OnIceCandidatesRemoved(const std::vector<cricket::Candidate>& candidates) override;
   void OnRenegotiationNeeded() override;
 
   void OnDataChannel(rtc::scoped_refptr<webrtc::DataChannelInterface> data_channel) override;
@@ -63,7 +76,43 @@ class RTCPeerConnection
 
   static Napi::FunctionReference& constructor();
 
-  void SaveLastSdp(const RTCSessionDescriptionInit& lastSdp);
+  /**
+   * Save the description last created by createOffer or createAnswer, and
+   * its parsed form, which setLocalDescription takes instead of re-parsing
+   * the same SDP. May be called from any thread.
+   */
+  void SaveLastSdp(const RTCSessionDescriptionInit& lastSdp, std::unique_ptr<webrtc::SessionDescriptionInterface> lastDescription);
+
+  /**
+   * Forget the cached SDP of every description, since one may have changed.
+   * May be called from any thread.
+   */
+  void InvalidateCachedDescriptions();
+
+  /**
+   * Called by the RTCPeerConnection's StatsSubscription, on the signaling
+   * thread, with the stats that changed.
+   */
+  void OnStats(RTCStatsBuffer delta);
+
+  /**
+   * Called by the RTCPeerConnection's IceCandidateBatcher, on the signaling
+   * thread, with a batch of local ICE candidates.
+   */
+  void OnIceCandidates(std::vector<std::shared_ptr<webrtc::IceCandidateInterface>> candidates, bool complete);
+
+  /**
+   * Resolve |deferred| with an RTCStatsReport of |sender|'s or |receiver|'s
+   * stats only, as RTCRtpSender and RTCRtpReceiver's getStats do.
+   */
+  void GetSelectedStats(
+      Napi::Promise::Deferred deferred,
+      rtc::scoped_refptr<webrtc::RtpSenderInterface> sender,
+      std::shared_ptr<const RTCStatsFilter> filter);
+  void GetSelectedStats(
+      Napi::Promise::Deferred deferred,
+      rtc::scoped_refptr<webrtc::RtpReceiverInterface> receiver,
+      std::shared_ptr<const RTCStatsFilter> filter);
 
  private:
   Napi::Value AddTrack(const Napi::CallbackInfo&);
@@ -75,6 +124,7 @@ class RTCPeerConnection
   Napi::Value SetRemoteDescription(const Napi::CallbackInfo&);
   Napi::Value UpdateIce(const Napi::CallbackInfo&);
   Napi::Value AddIceCandidate(const Napi::CallbackInfo&);
+  Napi::Value AddIceCandidates(const Napi::CallbackInfo&);
   Napi::Value CreateDataChannel(const Napi::CallbackInfo&);
   /*
   Napi::Value GetLocalStreams(const Napi::CallbackInfo&);
@@ -88,6 +138,12 @@ class RTCPeerConnection
   Napi::Value GetReceivers(const Napi::CallbackInfo&);
   Napi::Value GetSenders(const Napi::CallbackInfo&);
   Napi::Value GetStats(const Napi::CallbackInfo&);
+  Napi::Value GetStatsBuffer(const Napi::CallbackInfo&);
+  static Napi::Value CollectStats(const Napi::CallbackInfo&);
+  Napi::Value SubscribeStats(const Napi::CallbackInfo&);
+  Napi::Value UnsubscribeStats(const Napi::CallbackInfo&);
+  Napi::Value BatchIceCandidates(const Napi::CallbackInfo&);
+  Napi::Value UnbatchIceCandidates(const Napi::CallbackInfo&);
   Napi::Value LegacyGetStats(const Napi::CallbackInfo&);
   Napi::Value GetTransceivers(const Napi::CallbackInfo&);
   Napi::Value Close(const Napi::CallbackInfo&);
@@ -106,16 +162,46 @@ class RTCPeerConnection
   Napi::Value GetSignalingState(const Napi::CallbackInfo&);
   Napi::Value GetIceGatheringState(const Napi::CallbackInfo&);
 
+  // Convert |description| to an RTCSessionDescriptionInit, printing its SDP
+  // only if it changed since it was last converted.
+  Napi::Value GetCachedDescription(Napi::Env env, const webrtc::SessionDescriptionInterface* description);
+
+  void ReleaseFactory();
+  void StopStatsSubscription();
+  void SetIceCandidateBatcher(std::unique_ptr<IceCandidateBatcher> batcher);
+
+  std::mutex _lastSdpMutex;
   RTCSessionDescriptionInit _lastSdp;
+  std::unique_ptr<webrtc::SessionDescriptionInterface> _lastDescription;
+
+  // A description's SDP, kept as a JavaScript string. The cache is keyed by
+  // description, and cleared whenever a description may have changed: when
+  // setting one completes, and when candidates are added or removed.
+  struct CachedDescription {
+    RTCSdpType type;
+    Napi::Reference<Napi::String> sdp;
+  };
+  std::unordered_map<const webrtc::SessionDescriptionInterface*, CachedDescription> _cachedDescriptions;
+  uint64_t _cachedDescriptionsVersion = 0;
+  std::atomic<uint64_t> _descriptionsVersion{0};
 
   UnsignedShortRange _port_range;
   ExtendedRTCConfiguration _cached_configuration;
   rtc::scoped_refptr<webrtc::PeerConnectionInterface> _jinglePeerConnection;
 
-  PeerConnectionFactory* _factory;
-  bool _shouldReleaseFactory;
+  PeerConnectionFactory* _factory = nullptr;
+  bool _shouldReleaseFactory = false;
+  std::unique_ptr<SharedUdpSocketFactory> _sharedUdpSocketFactory;
+  rtc::scoped_refptr<StatsSubscription> _statsSubscription;
+
+  // Only used on the signaling thread.
+  std::unique_ptr<IceCandidateBatcher> _iceCandidateBatcher;
+  // Whether |_iceCandidateBatcher| is set, for use on the Node thread.
+  bool _batchingIceCandidates = false;
 
   std::vector<RTCDataChannel*> _channels;
 };
 
+DECLARE_FROM_NAPI(RTCPeerConnection*)
+
 }  // namespace node_webrtc
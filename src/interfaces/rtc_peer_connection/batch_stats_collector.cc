@@ -0,0 +1,116 @@
+/* Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#include "src/interfaces/rtc_peer_connection/batch_stats_collector.h"
+
+#include <map>
+#include <utility>
+
+#include <webrtc/api/stats/rtc_stats_collector_callback.h>
+#include <webrtc/api/stats/rtc_stats_report.h>
+#include <webrtc/rtc_base/location.h>
+#include <webrtc/rtc_base/ref_counted_object.h>
+#include <webrtc/rtc_base/thread.h>
+
+#include "src/dictionaries/node_webrtc/rtc_stats_buffer.h"
+#include "src/node/events.h"
+#include "src/node/utility.h"
+
+namespace node_webrtc {
+
+class BatchStatsCollector::Callback : public webrtc::RTCStatsCollectorCallback {
+ public:
+  Callback(BatchStatsCollector* collector, size_t index)
+    : _collector(collector)
+    , _index(index) {}
+
+  void OnStatsDelivered(const rtc::scoped_refptr<const webrtc::RTCStatsReport>& report) override {
+    _collector->OnStatsDelivered(_index, report);
+  }
+
+ private:
+  BatchStatsCollector* _collector;
+  size_t _index;
+};
+
+BatchStatsCollector::BatchStatsCollector(
+    Napi::Env env,
+    Napi::AsyncContext* context,
+    Napi::Promise::Deferred deferred,
+    size_t size,
+    std::shared_ptr<const RTCStatsFilter> filter)
+  : EventLoop<BatchStatsCollector>(env, context, *this)
+  , _context(context)
+  , _deferred(deferred)
+  , _filter(std::move(filter))
+  , _reports(size)
+  , _remaining(size) {}
+
+void BatchStatsCollector::Collect(
+    Napi::Env env,
+    Napi::Promise::Deferred deferred,
+    const std::vector<Connection>& connections,
+    std::shared_ptr<const RTCStatsFilter> filter) {
+  auto collector = new BatchStatsCollector(env, new Napi::AsyncContext(env, "RTCPeerConnection:collectStats"),
+          deferred, connections.size(), std::move(filter));
+
+  std::map<rtc::Thread*, std::vector<size_t>> indicesBySignalingThread;
+  for (size_t i = 0; i < connections.size(); i++) {
+    if (connections[i].peerConnection) {
+      indicesBySignalingThread[connections[i].signalingThread].push_back(i);
+    }
+  }
+
+  for (auto& pair : indicesBySignalingThread) {
+    auto& indices = pair.second;
+    pair.first->Invoke<void>(RTC_FROM_HERE, [collector, &connections, &indices]() {
+      for (auto i : indices) {
+        connections[i].peerConnection->GetStats(new rtc::RefCountedObject<Callback>(collector, i));
+      }
+    });
+  }
+
+  if (connections.empty()) {
+    collector->Resolve();
+    return;
+  }
+
+  // Closed RTCPeerConnections have nothing to collect.
+  for (size_t i = 0; i < connections.size(); i++) {
+    if (!connections[i].peerConnection) {
+      collector->OnStatsDelivered(i, nullptr);
+    }
+  }
+}
+
+void BatchStatsCollector::OnStatsDelivered(size_t index, rtc::scoped_refptr<const webrtc::RTCStatsReport> report) {
+  _reports[index] = std::move(report);
+  if (!--_remaining) {
+    Resolve();
+  }
+}
+
+void BatchStatsCollector::Resolve() {
+  std::vector<const webrtc::RTCStatsReport*> reports;
+  reports.reserve(_reports.size());
+  for (auto& report : _reports) {
+    reports.push_back(report.get());
+  }
+  auto buffer = RTCStatsBuffer::Create(reports, _filter.get());
+
+  Dispatch(CreateCallback<BatchStatsCollector>([this, buffer]() {
+    node_webrtc::Resolve(_deferred, buffer);
+    _reports.clear();
+    Stop();
+  }));
+}
+
+void BatchStatsCollector::DidStop() {
+  delete this;
+}
+
+}  // namespace node_webrtc
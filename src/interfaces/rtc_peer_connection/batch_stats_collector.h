@@ -0,0 +1,77 @@
+/* Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <node-addon-api/napi.h>
+#include <webrtc/api/peer_connection_interface.h>
+#include <webrtc/api/scoped_refptr.h>
+
+#include "src/node/event_loop.h"
+
+namespace rtc { class Thread; }
+namespace webrtc { class RTCStatsReport; }
+
+namespace node_webrtc {
+
+struct RTCStatsFilter;
+
+/**
+ * A BatchStatsCollector collects the stats of many RTCPeerConnections and
+ * resolves a single Promise with one RTCStatsBuffer of them all. The
+ * RTCPeerConnections sharing a signaling thread start collecting in a single
+ * task on that thread, instead of one blocking call each from the Node thread,
+ * and the buffer is built off the Node thread, once the last report arrives.
+ *
+ * A BatchStatsCollector deletes itself after resolving its Promise.
+ */
+class BatchStatsCollector : public EventLoop<BatchStatsCollector> {
+ public:
+  struct Connection {
+    rtc::Thread* signalingThread;
+    // Null if the RTCPeerConnection is closed.
+    rtc::scoped_refptr<webrtc::PeerConnectionInterface> peerConnection;
+  };
+
+  static void Collect(
+      Napi::Env env,
+      Napi::Promise::Deferred deferred,
+      const std::vector<Connection>& connections,
+      std::shared_ptr<const RTCStatsFilter> filter);
+
+ protected:
+  void DidStop() override;
+
+ private:
+  class Callback;
+
+  BatchStatsCollector(
+      Napi::Env env,
+      Napi::AsyncContext* context,
+      Napi::Promise::Deferred deferred,
+      size_t size,
+      std::shared_ptr<const RTCStatsFilter> filter);
+
+  void OnStatsDelivered(size_t index, rtc::scoped_refptr<const webrtc::RTCStatsReport> report);
+
+  // Build the RTCStatsBuffer and resolve the Promise with it, on the Node
+  // thread. Called once every report has been delivered.
+  void Resolve();
+
+  std::unique_ptr<Napi::AsyncContext> _context;
+  Napi::Promise::Deferred _deferred;
+  std::shared_ptr<const RTCStatsFilter> _filter;
+  std::vector<rtc::scoped_refptr<const webrtc::RTCStatsReport>> _reports;
+  std::atomic<size_t> _remaining;
+};
+
+}  // namespace node_webrtc
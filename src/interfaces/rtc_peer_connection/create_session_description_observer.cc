@@ -7,21 +7,25 @@
  */
 #include "src/interfaces/rtc_peer_connection/create_session_description_observer.h"
 
+#include <memory>
 #include <type_traits>
+#include <utility>
 
 #include <webrtc/api/rtc_error.h>
 
 #include "src/converters/napi.h"
 #include "src/dictionaries/node_webrtc/some_error.h"
+#include "src/webrtc/sdp_edits.h"
 
 void node_webrtc::CreateSessionDescriptionObserver::OnSuccess(webrtc::SessionDescriptionInterface* description) {
-  auto maybeDescription = node_webrtc::From<RTCSessionDescriptionInit>(const_cast<const webrtc::SessionDescriptionInterface*>(description));
-  delete description;
+  std::unique_ptr<webrtc::SessionDescriptionInterface> parsed(description);
+  ApplySdpEdits(_sdpEdits, parsed->GetType(), parsed->description());
+  auto maybeDescription = node_webrtc::From<RTCSessionDescriptionInit>(const_cast<const webrtc::SessionDescriptionInterface*>(parsed.get()));
   if (maybeDescription.IsInvalid()) {
     Reject(node_webrtc::SomeError(maybeDescription.ToErrors()[0]));
   } else {
     auto description = maybeDescription.UnsafeFromValid();
-    _peer_connection->SaveLastSdp(description);
+    _peer_connection->SaveLastSdp(description, std::move(parsed));
     Resolve(description);
   }
 }
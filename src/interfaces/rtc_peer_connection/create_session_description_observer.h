@@ -8,9 +8,12 @@
 #pragma once
 
 #include <memory>
+#include <utility>
+#include <vector>
 
 #include <webrtc/api/jsep.h>
 
+#include "src/dictionaries/node_webrtc/rtc_sdp_edit.h"
 #include "src/interfaces/rtc_peer_connection.h"
 #include "src/node/promise.h"
 
@@ -26,9 +29,11 @@ class CreateSessionDescriptionObserver
  public:
   CreateSessionDescriptionObserver(
       RTCPeerConnection* peer_connection,
-      Napi::Promise::Deferred deferred)
+      Napi::Promise::Deferred deferred,
+      std::vector<RTCSdpEdit> sdpEdits = {})
     : PromiseCreator(peer_connection, deferred)
-    , _peer_connection(peer_connection) {}
+    , _peer_connection(peer_connection)
+    , _sdpEdits(std::move(sdpEdits)) {}
 
   void OnSuccess(webrtc::SessionDescriptionInterface*) override;
 
@@ -36,6 +41,7 @@ class CreateSessionDescriptionObserver
 
  private:
   RTCPeerConnection* _peer_connection;
+  std::vector<RTCSdpEdit> _sdpEdits;
 };
 
 }  // namespace node_webrtc
@@ -0,0 +1,59 @@
+/* Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#include "src/interfaces/rtc_peer_connection/ice_candidate_batcher.h"
+
+#include <utility>
+
+#include <webrtc/api/jsep.h>
+#include <webrtc/rtc_base/checks.h>
+#include <webrtc/rtc_base/location.h>
+#include <webrtc/rtc_base/thread.h>
+
+#include "src/interfaces/rtc_peer_connection.h"
+
+namespace node_webrtc {
+
+constexpr uint32_t IceCandidateBatcher::kDefaultWindowMs;
+
+IceCandidateBatcher::IceCandidateBatcher(
+    RTCPeerConnection* target,
+    rtc::Thread* signalingThread,
+    uint32_t windowMs)
+  : _target(target)
+  , _signalingThread(signalingThread)
+  , _windowMs(windowMs) {}
+
+IceCandidateBatcher::~IceCandidateBatcher() {
+  RTC_DCHECK(_signalingThread->IsCurrent());
+  _signalingThread->Clear(this);
+}
+
+void IceCandidateBatcher::Add(std::shared_ptr<webrtc::IceCandidateInterface> candidate) {
+  RTC_DCHECK(_signalingThread->IsCurrent());
+  _pending.push_back(std::move(candidate));
+  if (_pending.size() == 1) {
+    _signalingThread->PostDelayed(RTC_FROM_HERE, _windowMs, this);
+  }
+}
+
+void IceCandidateBatcher::Flush(bool complete) {
+  RTC_DCHECK(_signalingThread->IsCurrent());
+  _signalingThread->Clear(this);
+  if (_pending.empty() && !complete) {
+    return;
+  }
+  auto candidates = std::move(_pending);
+  _pending.clear();
+  _target->OnIceCandidates(std::move(candidates), complete);
+}
+
+void IceCandidateBatcher::OnMessage(rtc::Message*) {
+  Flush(false);
+}
+
+}  // namespace node_webrtc
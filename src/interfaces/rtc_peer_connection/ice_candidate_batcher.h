@@ -0,0 +1,61 @@
+/* Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <webrtc/rtc_base/message_handler.h>
+
+namespace rtc { class Thread; }
+namespace webrtc { class IceCandidateInterface; }
+
+namespace node_webrtc {
+
+class RTCPeerConnection;
+
+/**
+ * An IceCandidateBatcher collects an RTCPeerConnection's local ICE candidates
+ * and passes them to the RTCPeerConnection together, `windowMs` after the
+ * first one, or as soon as gathering completes, so that the last batch also
+ * signals end-of-candidates.
+ *
+ * An IceCandidateBatcher must be created, used, and destroyed on the
+ * signaling thread.
+ */
+class IceCandidateBatcher : public rtc::MessageHandler {
+ public:
+  static constexpr uint32_t kDefaultWindowMs = 10;
+
+  IceCandidateBatcher(
+      RTCPeerConnection* target,
+      rtc::Thread* signalingThread,
+      uint32_t windowMs);
+
+  ~IceCandidateBatcher() override;
+
+  void Add(std::shared_ptr<webrtc::IceCandidateInterface> candidate);
+
+  /**
+   * Pass the pending candidates to the target now. If |complete|, they are
+   * passed even if there are none.
+   */
+  void Flush(bool complete);
+
+  // rtc::MessageHandler
+  void OnMessage(rtc::Message*) override;
+
+ private:
+  RTCPeerConnection* _target;
+  rtc::Thread* _signalingThread;
+  uint32_t _windowMs;
+  std::vector<std::shared_ptr<webrtc::IceCandidateInterface>> _pending;
+};
+
+}  // namespace node_webrtc
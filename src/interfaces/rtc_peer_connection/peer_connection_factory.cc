@@ -7,36 +7,169 @@
  */
 #include "peer_connection_factory.h"
 
+#include <cstdint>
 #include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 
+#if defined(WEBRTC_LINUX)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include <absl/memory/memory.h>
 #include <webrtc/api/audio_codecs/builtin_audio_decoder_factory.h>
 #include <webrtc/api/audio_codecs/builtin_audio_encoder_factory.h>
-#include <webrtc/api/create_peerconnection_factory.h>
+#include <webrtc/api/call/call_factory_interface.h>
 #include <webrtc/api/peer_connection_interface.h>
+#include <webrtc/api/rtc_event_log/rtc_event_log_factory.h>
+#include <webrtc/api/task_queue/default_task_queue_factory.h>
 #include <webrtc/api/video_codecs/builtin_video_decoder_factory.h>
 #include <webrtc/api/video_codecs/builtin_video_encoder_factory.h>
 #include <webrtc/api/video_codecs/video_decoder_factory.h>
 #include <webrtc/api/video_codecs/video_encoder_factory.h>
+#include <webrtc/media/engine/webrtc_media_engine.h>
 #include <webrtc/modules/audio_device/include/audio_device.h>
 #include <webrtc/modules/audio_device/include/fake_audio_device.h>
+#include <webrtc/modules/audio_processing/include/audio_processing.h>
 #include <webrtc/p2p/base/basic_packet_socket_factory.h>
+#include <webrtc/p2p/client/basic_port_allocator.h>
 #include <webrtc/rtc_base/location.h>
+#include <webrtc/rtc_base/logging.h>
+#include <webrtc/rtc_base/socket_server.h>
 #include <webrtc/rtc_base/ssl_adapter.h>
+#include <webrtc/rtc_base/system/file_wrapper.h>
 #include <webrtc/rtc_base/thread.h>
-
+#include <webrtc/rtc_base/time_utils.h>
+
+#include "src/converters.h"
+#include "src/converters/arguments.h"
+#include "src/node/error_factory.h"
+#include "src/webrtc/batching_packet_socket_factory.h"
+#include "src/webrtc/caching_network_manager.h"
+#include "src/webrtc/ice_candidate_pool.h"
+#include "src/webrtc/epoll_socket_server.h"
+#include "src/webrtc/pooled_task_queue_factory.h"
+#include "src/webrtc/shared_udp_socket_factory.h"
 #include "src/webrtc/test_audio_device_module.h"
 #include "src/webrtc/zero_capturer.h"
 
 namespace node_webrtc {
 
+static std::unique_ptr<TestAudioDeviceModule::Capturer> CreateCapturer(const PeerConnectionFactoryOptions& options) {
+  if (options.audioCapturer == kZeroAudioCapturer) {
+    return ZeroCapturer::Create(48000);
+  }
+  return nullptr;
+}
+
+static std::unique_ptr<TestAudioDeviceModule::Renderer> CreateRenderer(const PeerConnectionFactoryOptions& options) {
+  if (options.audioRenderer == kDiscardAudioRenderer) {
+    return TestAudioDeviceModule::CreateDiscardRenderer(48000);
+  } else if (options.audioRenderer == kWavFileAudioRenderer) {
+    return TestAudioDeviceModule::CreateWavFileWriter(options.audioRendererFile.UnsafeFromJust(), 48000);
+  }
+  return nullptr;
+}
+
+// webrtc::WavWriter aborts if it cannot open its file, so check that the
+// "wav" renderer's file can be opened before creating the audio device.
+static bool CanOpenAudioRendererFile(const PeerConnectionFactoryOptions& options) {
+  if (options.audioRenderer != kWavFileAudioRenderer) {
+    return true;
+  }
+  auto file = webrtc::FileWrapper::OpenWriteOnly(options.audioRendererFile.UnsafeFromJust());
+  return file.is_open();
+}
+
+static std::string CannotOpenAudioRendererFile(const PeerConnectionFactoryOptions& options) {
+  return "Cannot open .audioRendererFile \"" + options.audioRendererFile.UnsafeFromJust() + "\" for writing";
+}
+
+static std::unique_ptr<rtc::Thread> CreateThread(
+    std::unique_ptr<rtc::Thread> thread,
+    const std::string& name,
+    const Maybe<std::vector<uint32_t>>& affinity) {
+  assert(thread);
+
+  bool result = thread->SetName(name, nullptr);
+  assert(result);
+
+  result = thread->Start();
+  assert(result);
+  (void) result;
+
+#if defined(WEBRTC_LINUX)
+  if (affinity.IsJust()) {
+    auto cpus = affinity.UnsafeFromJust();
+    thread->Invoke<void>(RTC_FROM_HERE, [&cpus]() {
+      cpu_set_t cpuset;
+      CPU_ZERO(&cpuset);
+      for (auto cpu : cpus) {
+        if (cpu < CPU_SETSIZE) {
+          CPU_SET(cpu, &cpuset);
+        }
+      }
+      if (pthread_setaffinity_np(pthread_self(), sizeof(cpuset), &cpuset)) {
+        RTC_LOG(LS_WARNING) << "Failed to set the CPU affinity of " << rtc::Thread::Current()->name();
+      }
+    });
+  }
+#else
+  (void) affinity;
+#endif
+
+  return thread;
+}
+
 Napi::FunctionReference& PeerConnectionFactory::constructor() {
   static Napi::FunctionReference constructor;
   return constructor;
 }
 
 PeerConnectionFactory* PeerConnectionFactory::_default = nullptr;
+PeerConnectionFactoryOptions PeerConnectionFactory::_defaultOptions{};  // NOLINT
 std::mutex PeerConnectionFactory::_mutex{};  // NOLINT
 int PeerConnectionFactory::_references = 0;
+bool PeerConnectionFactory::_warmupReference = false;
+
+/**
+ * A WarmupWorker initializes a PeerConnectionFactory on the libuv thread pool,
+ * or, if someone else is already initializing it, waits for them to finish.
+ */
+class PeerConnectionFactory::WarmupWorker: public Napi::AsyncWorker {
+ public:
+  WarmupWorker(
+      Napi::Env env,
+      PeerConnectionFactory* factory,
+      Maybe<PeerConnectionFactoryOptions> options,
+      Napi::Promise::Deferred deferred)
+    : Napi::AsyncWorker(env, "RTCPeerConnectionFactory:warmup")
+    , _factory(factory)
+    , _options(std::move(options))
+    , _deferred(deferred) {
+    _factory->Ref();
+  }
+
+  void Execute() override {
+    if (_options.IsJust()) {
+      _factory->Initialize(_options.UnsafeFromJust());
+    } else {
+      _factory->WaitUntilInitialized();
+    }
+  }
+
+  void OnOK() override {
+    _deferred.Resolve(_factory->Value());
+    _factory->Unref();
+  }
+
+ private:
+  PeerConnectionFactory* _factory;
+  Maybe<PeerConnectionFactoryOptions> _options;
+  Napi::Promise::Deferred _deferred;
+};
 
 PeerConnectionFactory::PeerConnectionFactory(const Napi::CallbackInfo& info)
   : Napi::ObjectWrap<PeerConnectionFactory>(info) {
@@ -47,81 +180,191 @@ PeerConnectionFactory::PeerConnectionFactory(const Napi::CallbackInfo& info)
     return;
   }
 
-  // TODO(mroberts): Read `audioLayer` from some PeerConnectionFactoryOptions?
-  auto audioLayer = MakeNothing<webrtc::AudioDeviceModule::AudioLayer>();
+  // NOTE: `warmup` passes its options as an External and calls Initialize
+  // itself, off the Node thread.
+  if (info.Length() > 0 && info[0].IsExternal()) {
+    return;
+  }
 
-  _workerThread = rtc::Thread::CreateWithSocketServer();
-  assert(_workerThread);
+  CONVERT_ARGS_OR_THROW_AND_RETURN_VOID_NAPI(info, maybeOptions, Maybe<PeerConnectionFactoryOptions>)
+  auto options = maybeOptions.FromMaybe(_defaultOptions);
+  if (!CanOpenAudioRendererFile(options)) {
+    Napi::TypeError::New(env, CannotOpenAudioRendererFile(options)).ThrowAsJavaScriptException();
+    return;
+  }
+  Initialize(options);
+}
 
-  bool result = _workerThread->SetName("PeerConnectionFactory:workerThread", nullptr);
-  assert(result);
+void PeerConnectionFactory::Initialize(const PeerConnectionFactoryOptions& options) {
+  auto start = rtc::TimeMicros();
 
-  result = _workerThread->Start();
-  assert(result);
+  // TODO(mroberts): Read `audioLayer` from some PeerConnectionFactoryOptions?
+  auto audioLayer = MakeNothing<webrtc::AudioDeviceModule::AudioLayer>();
 
-  _audioDeviceModule = _workerThread->Invoke<rtc::scoped_refptr<webrtc::AudioDeviceModule>>(RTC_FROM_HERE, [audioLayer]() {
-    return audioLayer.Map([](auto audioLayer) {
-      // TODO(mroberts): I'm just trying to get this to compile right now.
-      // We need to call something like CreateDefaultTaskQueueFactory().
-      // This code is currently unused, though.
-      return webrtc::AudioDeviceModule::Create(audioLayer, nullptr);
-    }).Or([]() {
-      return TestAudioDeviceModule::CreateTestAudioDeviceModule(
-              ZeroCapturer::Create(48000),
-              TestAudioDeviceModule::CreateDiscardRenderer(48000));
+  // Socket I/O happens on the network thread, so that it is never blocked
+  // behind media work on the worker thread.
+  std::unique_ptr<rtc::SocketServer> socketServer;
+#if defined(WEBRTC_LINUX)
+  if (options.networkSocketServer == kEpollSocketServer) {
+    _epollSocketServer = new EpollSocketServer();
+    socketServer = std::unique_ptr<rtc::SocketServer>(_epollSocketServer);
+  }
+#endif
+  if (!socketServer) {
+    socketServer = rtc::CreateDefaultSocketServer();
+  }
+  auto networkThread = std::unique_ptr<rtc::Thread>(new rtc::Thread(std::move(socketServer)));
+  _networkThread = CreateThread(std::move(networkThread),
+          options.threadNamePrefix + ":networkThread", options.networkThreadAffinity);
+  _workerThread = CreateThread(rtc::Thread::Create(),
+          options.threadNamePrefix + ":workerThread", options.workerThreadAffinity);
+
+  if (!options.dataChannelsOnly) {
+    _audioDeviceModule = _workerThread->Invoke<rtc::scoped_refptr<webrtc::AudioDeviceModule>>(RTC_FROM_HERE, [audioLayer, &options]() {
+      return audioLayer.Map([](auto audioLayer) {
+        // TODO(mroberts): I'm just trying to get this to compile right now.
+        // We need to call something like CreateDefaultTaskQueueFactory().
+        // This code is currently unused, though.
+        return webrtc::AudioDeviceModule::Create(audioLayer, nullptr);
+      }).Or([&options]() {
+        return TestAudioDeviceModule::CreateTestAudioDeviceModule(
+                CreateCapturer(options),
+                CreateRenderer(options),
+                static_cast<float>(options.audioSpeed));
+      });
     });
-  });
-
-  _signalingThread = rtc::Thread::Create();
-  assert(_signalingThread);
-
-  result = _signalingThread->SetName("PeerConnectionFactory:signalingThread", nullptr);
-  assert(result);
+  }
 
-  result = _signalingThread->Start();
-  assert(result);
+  _signalingThread = CreateThread(rtc::Thread::Create(),
+          options.threadNamePrefix + ":signalingThread", options.signalingThreadAffinity);
+
+  webrtc::PeerConnectionFactoryDependencies dependencies;
+  dependencies.network_thread = _networkThread.get();
+  dependencies.worker_thread = _workerThread.get();
+  dependencies.signaling_thread = _signalingThread.get();
+  // By default, every task queue (for example, one per video encoder) gets a
+  // thread of its own; `taskQueueThreads` bounds them to a shared pool.
+  dependencies.task_queue_factory = options.taskQueueThreads
+      ? CreatePooledTaskQueueFactory(options.taskQueueThreads, options.threadNamePrefix + ":taskQueue")
+      : webrtc::CreateDefaultTaskQueueFactory();
+  dependencies.event_log_factory = absl::make_unique<webrtc::RtcEventLogFactory>(
+          dependencies.task_queue_factory.get());
+
+  // Without a media engine and call factory, libwebrtc creates no
+  // webrtc::Call, codecs, or audio processing; only data channels work.
+  if (!options.dataChannelsOnly) {
+    dependencies.call_factory = webrtc::CreateCallFactory();
+
+    cricket::MediaEngineDependencies mediaDependencies;
+    mediaDependencies.task_queue_factory = dependencies.task_queue_factory.get();
+    mediaDependencies.adm = _audioDeviceModule;
+    mediaDependencies.audio_encoder_factory = webrtc::CreateBuiltinAudioEncoderFactory();
+    mediaDependencies.audio_decoder_factory = webrtc::CreateBuiltinAudioDecoderFactory();
+    mediaDependencies.audio_processing = webrtc::AudioProcessingBuilder().Create();
+    mediaDependencies.video_encoder_factory = webrtc::CreateBuiltinVideoEncoderFactory();
+    mediaDependencies.video_decoder_factory = webrtc::CreateBuiltinVideoDecoderFactory();
+    dependencies.media_engine = cricket::CreateMediaEngine(std::move(mediaDependencies));
+  }
 
-  _factory = webrtc::CreatePeerConnectionFactory(
-          _workerThread.get(),
-          _workerThread.get(),
-          _signalingThread.get(),
-          _audioDeviceModule.get(),
-          webrtc::CreateBuiltinAudioEncoderFactory(),
-          webrtc::CreateBuiltinAudioDecoderFactory(),
-          webrtc::CreateBuiltinVideoEncoderFactory(),
-          webrtc::CreateBuiltinVideoDecoderFactory(),
-          nullptr,
-          nullptr);
+  _factory = webrtc::CreateModularPeerConnectionFactory(std::move(dependencies));
   assert(_factory);
 
-  webrtc::PeerConnectionFactoryInterface::Options options;
-  options.network_ignore_mask = 0;
-  _factory->SetOptions(options);
-
-  _networkManager = std::unique_ptr<rtc::NetworkManager>(new rtc::BasicNetworkManager());
+  webrtc::PeerConnectionFactoryInterface::Options factoryOptions;
+  factoryOptions.network_ignore_mask = 0;
+  _factory->SetOptions(factoryOptions);
+
+  if (options.cacheNetworks
+      || options.networkInterfaceAllowlist.IsJust()
+      || options.networkInterfaceDenylist.IsJust()) {
+    _networkManager = std::unique_ptr<rtc::NetworkManager>(new CachingNetworkManager(
+                _networkThread.get(),
+                options.networkInterfaceAllowlist.FromMaybe(std::vector<std::string>()),
+                options.networkInterfaceDenylist.FromMaybe(std::vector<std::string>()),
+                options.networkRefreshInterval,
+                options.threadNamePrefix + ":networkMonitor"));
+  } else {
+    _networkManager = std::unique_ptr<rtc::NetworkManager>(new rtc::BasicNetworkManager());
+  }
   assert(_networkManager != nullptr);
 
-  _socketFactory = std::unique_ptr<rtc::PacketSocketFactory>(new rtc::BasicPacketSocketFactory(_workerThread.get()));
+#if defined(WEBRTC_LINUX)
+  // Only sockets created by the BatchingPacketSocketFactory are registered
+  // with the EpollSocketServer's edge-triggered set.
+  if (options.udpBatching || _epollSocketServer) {
+    _socketFactory = std::unique_ptr<rtc::PacketSocketFactory>(
+            new BatchingPacketSocketFactory(_networkThread.get(), _epollSocketServer));
+  } else {
+    _socketFactory = std::unique_ptr<rtc::PacketSocketFactory>(new rtc::BasicPacketSocketFactory(_networkThread.get()));
+  }
+#else
+  _socketFactory = std::unique_ptr<rtc::PacketSocketFactory>(new rtc::BasicPacketSocketFactory(_networkThread.get()));
+#endif
   assert(_socketFactory != nullptr);
+
+  if (options.iceCandidatePoolSize) {
+    _iceCandidatePool = _networkThread->Invoke<std::unique_ptr<IceCandidatePool>>(RTC_FROM_HERE, [this, &options]() {
+      return std::unique_ptr<IceCandidatePool>(new IceCandidatePool(
+                  _networkThread.get(),
+                  _networkManager.get(),
+                  _socketFactory.get(),
+                  options.iceCandidatePoolSize,
+                  static_cast<int>(options.iceCandidatePoolTtl)));
+    });
+  }
+
+  if (options.sharedUdpPort.IsJust()) {
+    _sharedUdpSocketMux = std::unique_ptr<SharedUdpSocketMux>(new SharedUdpSocketMux(
+                _networkThread.get(), _socketFactory.get(), options.sharedUdpPort.UnsafeFromJust()));
+  }
+
+  _initializationTime = static_cast<double>(rtc::TimeMicros() - start) / rtc::kNumMicrosecsPerMillisec;
+  _initialized.Set();
 }
 
 PeerConnectionFactory::~PeerConnectionFactory() {
+  if (!_initialized.Wait(0)) {
+    return;
+  }
+
   _factory = nullptr;
 
   _workerThread->Invoke<void>(RTC_FROM_HERE, [this]() {
     this->_audioDeviceModule = nullptr;
   });
 
+  // The ICE candidate pool, shared UDP sockets, and network manager must be
+  // destroyed on the network thread.
+  _networkThread->Invoke<void>(RTC_FROM_HERE, [this]() {
+    this->_iceCandidatePool = nullptr;
+    this->_sharedUdpSocketMux = nullptr;
+    this->_networkManager = nullptr;
+  });
+
   _workerThread->Stop();
   _signalingThread->Stop();
+  _networkThread->Stop();
 
   _workerThread = nullptr;
   _signalingThread = nullptr;
+  _networkThread = nullptr;
+  _epollSocketServer = nullptr;
 
-  _networkManager = nullptr;
   _socketFactory = nullptr;
 }
 
+std::unique_ptr<cricket::PortAllocator> PeerConnectionFactory::CreatePortAllocator(rtc::PacketSocketFactory* socketFactory) {
+  WaitUntilInitialized();
+  if (_iceCandidatePool) {
+    return _iceCandidatePool->CreatePortAllocator(_networkManager.get(), socketFactory);
+  }
+  return std::unique_ptr<cricket::PortAllocator>(new cricket::BasicPortAllocator(_networkManager.get(), socketFactory));
+}
+
+std::unique_ptr<SharedUdpSocketFactory> PeerConnectionFactory::CreateSharedUdpSocketFactory() {
+  WaitUntilInitialized();
+  return _sharedUdpSocketMux ? _sharedUdpSocketMux->CreateSocketFactory() : nullptr;
+}
+
 PeerConnectionFactory* PeerConnectionFactory::GetOrCreateDefault() {
   _mutex.lock();
   _references++;
@@ -133,6 +376,10 @@ PeerConnectionFactory* PeerConnectionFactory::GetOrCreateDefault() {
     auto factory = Unwrap(object);
     _default = factory;
     _default->Ref();
+  } else if (_warmupReference) {
+    // Take over the reference `warmup` held.
+    _warmupReference = false;
+    _references--;
   }
   _mutex.unlock();
   return _default;
@@ -150,6 +397,87 @@ void PeerConnectionFactory::Release() {
   _mutex.unlock();
 }
 
+Napi::Value PeerConnectionFactory::SetDefaultOptions(const Napi::CallbackInfo& info) {
+  auto env = info.Env();
+  CONVERT_ARGS_OR_THROW_AND_RETURN_NAPI(info, options, PeerConnectionFactoryOptions)
+  // The default factory is created without a chance to throw, so check here.
+  if (!CanOpenAudioRendererFile(options)) {
+    Napi::TypeError::New(env, CannotOpenAudioRendererFile(options)).ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  _mutex.lock();
+  if (_default) {
+    _mutex.unlock();
+    Napi::Error(env, ErrorFactory::CreateInvalidStateError(env,
+            "Cannot setDefaultOptions; the default RTCPeerConnectionFactory has already been created")).ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  _defaultOptions = options;
+  _mutex.unlock();
+  return env.Undefined();
+}
+
+Napi::Value PeerConnectionFactory::Warmup(const Napi::CallbackInfo& info) {
+  auto env = info.Env();
+  auto deferred = Napi::Promise::Deferred::New(env);
+  auto options = MakeNothing<PeerConnectionFactoryOptions>();
+  _mutex.lock();
+  if (!_default) {
+    options = MakeJust(_defaultOptions);
+    auto object = constructor().New({ Napi::External<PeerConnectionFactoryOptions>::New(env, &_defaultOptions) });
+    _default = Unwrap(object);
+    _default->Ref();
+    _references++;
+    _warmupReference = true;
+  }
+  auto worker = new WarmupWorker(env, _default, options, deferred);
+  _mutex.unlock();
+  worker->Queue();
+  return deferred.Promise();
+}
+
+Napi::Value PeerConnectionFactory::GetInitializationTime(const Napi::CallbackInfo& info) {
+  CONVERT_OR_THROW_AND_RETURN_NAPI(info.Env(), _initializationTime, result, Napi::Value)
+  return result;
+}
+
+Napi::Value PeerConnectionFactory::GetNetworkThreadStats(const Napi::CallbackInfo& info) {
+  auto env = info.Env();
+  WaitUntilInitialized();
+#if defined(WEBRTC_LINUX)
+  if (_epollSocketServer) {
+    auto stats = _epollSocketServer->GetStats();
+    auto object = Napi::Object::New(env);
+    object.Set("wakeups", Napi::Number::New(env, static_cast<double>(stats.wakeups)));
+    object.Set("iterations", Napi::Number::New(env, static_cast<double>(stats.iterations)));
+    object.Set("events", Napi::Number::New(env, static_cast<double>(stats.events)));
+    object.Set("time", Napi::Number::New(env, static_cast<double>(stats.time_us) / rtc::kNumMicrosecsPerMillisec));
+    return object;
+  }
+#endif
+  return env.Null();
+}
+
+Napi::Value PeerConnectionFactory::GetIceCandidatePoolStats(const Napi::CallbackInfo& info) {
+  auto env = info.Env();
+  WaitUntilInitialized();
+  if (!_iceCandidatePool) {
+    return env.Null();
+  }
+  auto stats = _iceCandidatePool->GetStats();
+  auto object = Napi::Object::New(env);
+  object.Set("size", Napi::Number::New(env, stats.size));
+  object.Set("hits", Napi::Number::New(env, static_cast<double>(stats.hits)));
+  object.Set("misses", Napi::Number::New(env, static_cast<double>(stats.misses)));
+  object.Set("expired", Napi::Number::New(env, static_cast<double>(stats.expired)));
+  return object;
+}
+
+Napi::Value PeerConnectionFactory::GetPeerConnectionCount(const Napi::CallbackInfo& info) {
+  CONVERT_OR_THROW_AND_RETURN_NAPI(info.Env(), _peerConnections, result, Napi::Value)
+  return result;
+}
+
 void PeerConnectionFactory::Dispose() {
   rtc::CleanupSSL();
 }
@@ -161,7 +489,14 @@ void PeerConnectionFactory::Init(Napi::Env env, Napi::Object exports) {
   result = rtc::InitializeSSL();
   assert(result);
 
-  auto func = DefineClass(env, "RTCPeerConnectionFactory", {});
+  auto func = DefineClass(env, "RTCPeerConnectionFactory", {
+    StaticMethod("setDefaultOptions", &PeerConnectionFactory::SetDefaultOptions),
+    StaticMethod("warmup", &PeerConnectionFactory::Warmup),
+    InstanceAccessor("iceCandidatePoolStats", &PeerConnectionFactory::GetIceCandidatePoolStats, nullptr),
+    InstanceAccessor("initializationTime", &PeerConnectionFactory::GetInitializationTime, nullptr),
+    InstanceAccessor("networkThreadStats", &PeerConnectionFactory::GetNetworkThreadStats, nullptr),
+    InstanceAccessor("peerConnectionCount", &PeerConnectionFactory::GetPeerConnectionCount, nullptr)
+  });
 
   constructor() = Napi::Persistent(func);
   constructor().SuppressDestruct();
@@ -169,4 +504,21 @@ void PeerConnectionFactory::Init(Napi::Env env, Napi::Object exports) {
   exports.Set("RTCPeerConnectionFactory", func);
 }
 
+FROM_NAPI_IMPL(PeerConnectionFactory*, value) {
+  return From<Napi::Object>(value).FlatMap<PeerConnectionFactory*>([](Napi::Object object) {
+    auto isPeerConnectionFactory = false;
+    napi_instanceof(object.Env(), object, PeerConnectionFactory::constructor().Value(), &isPeerConnectionFactory);
+    if (object.Env().IsExceptionPending()) {
+      return Validation<PeerConnectionFactory*>::Invalid(object.Env().GetAndClearPendingException().Message());
+    } else if (!isPeerConnectionFactory) {
+      return Validation<PeerConnectionFactory*>::Invalid("This is not an instance of RTCPeerConnectionFactory");
+    }
+    return Pure(PeerConnectionFactory::Unwrap(object));
+  });
+}
+
+TO_NAPI_IMPL(PeerConnectionFactory*, pair) {
+  return Pure(pair.second->Value().As<Napi::Value>());
+}
+
 }  // namespace node_webrtc
@@ -7,6 +7,7 @@
  */
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <mutex>
 
@@ -14,9 +15,18 @@
 #include <webrtc/api/peer_connection_interface.h>
 #include <webrtc/api/scoped_refptr.h>
 #include <webrtc/modules/audio_device/include/audio_device.h>
+#include <webrtc/rtc_base/event.h>
 
+#include "src/converters/napi.h"
+#include "src/dictionaries/node_webrtc/peer_connection_factory_options.h"
 #include "src/functional/maybe.h"
 
+namespace cricket {
+
+class PortAllocator;
+
+}  // namespace cricket
+
 namespace rtc {
 
 class NetworkManager;
@@ -33,6 +43,11 @@ class PeerConnectionFactoryInterface;
 
 namespace node_webrtc {
 
+class EpollSocketServer;
+class IceCandidatePool;
+class SharedUdpSocketFactory;
+class SharedUdpSocketMux;
+
 class PeerConnectionFactory
   : public Napi::ObjectWrap<PeerConnectionFactory> {
  public:
@@ -42,7 +57,8 @@ class PeerConnectionFactory
 
   /**
    * Get or create the default PeerConnectionFactory. The default uses
-   * webrtc::AudioDeviceModule::AudioLayer::kDummyAudio. Call {@link Release} when done.
+   * webrtc::AudioDeviceModule::AudioLayer::kDummyAudio and the options passed
+   * to `setDefaultOptions`, if any. Call {@link Release} when done.
    */
   static PeerConnectionFactory* GetOrCreateDefault();
 
@@ -52,13 +68,42 @@ class PeerConnectionFactory
   static void Release();
 
   /**
-   * Get the underlying webrtc::PeerConnectionFactoryInterface.
+   * Get the underlying webrtc::PeerConnectionFactoryInterface. If the
+   * PeerConnectionFactory is still warming up, this blocks until it is ready.
    */
-  rtc::scoped_refptr<webrtc::PeerConnectionFactoryInterface> factory() { return _factory; }
+  rtc::scoped_refptr<webrtc::PeerConnectionFactoryInterface> factory() {
+    WaitUntilInitialized();
+    return _factory;
+  }
 
-  rtc::NetworkManager* getNetworkManager() { return _networkManager.get(); }
+  rtc::NetworkManager* getNetworkManager() {
+    WaitUntilInitialized();
+    return _networkManager.get();
+  }
 
-  rtc::PacketSocketFactory* getSocketFactory() { return _socketFactory.get(); }
+  rtc::PacketSocketFactory* getSocketFactory() {
+    WaitUntilInitialized();
+    return _socketFactory.get();
+  }
+
+  /**
+   * Create a port allocator for an RTCPeerConnection, using |socketFactory|.
+   * If the `iceCandidatePoolSize` option is set, it claims sessions from the
+   * factory's IceCandidatePool.
+   */
+  std::unique_ptr<cricket::PortAllocator> CreatePortAllocator(rtc::PacketSocketFactory* socketFactory);
+
+  /**
+   * If the `sharedUdpPort` option is set, create a SharedUdpSocketFactory for
+   * an RTCPeerConnection; otherwise, return nullptr.
+   */
+  std::unique_ptr<SharedUdpSocketFactory> CreateSharedUdpSocketFactory();
+
+  /**
+   * Track the number of RTCPeerConnections using this PeerConnectionFactory.
+   */
+  void AddPeerConnection() { _peerConnections++; }
+  void RemovePeerConnection() { _peerConnections--; }
 
   static void Init(Napi::Env, Napi::Object);
 
@@ -66,19 +111,53 @@ class PeerConnectionFactory
 
   static void Dispose();
 
+  std::unique_ptr<rtc::Thread> _networkThread;
   std::unique_ptr<rtc::Thread> _signalingThread;
   std::unique_ptr<rtc::Thread> _workerThread;
 
  private:
+  class WarmupWorker;
+
+  /**
+   * Create the threads, audio device module, and webrtc::PeerConnectionFactory.
+   * This does not touch JavaScript, so it may run off the Node thread.
+   */
+  void Initialize(const PeerConnectionFactoryOptions&);
+
+  void WaitUntilInitialized() { _initialized.Wait(rtc::Event::kForever); }
+
+  static Napi::Value SetDefaultOptions(const Napi::CallbackInfo&);
+  static Napi::Value Warmup(const Napi::CallbackInfo&);
+
+  Napi::Value GetInitializationTime(const Napi::CallbackInfo&);
+  Napi::Value GetNetworkThreadStats(const Napi::CallbackInfo&);
+  Napi::Value GetIceCandidatePoolStats(const Napi::CallbackInfo&);
+  Napi::Value GetPeerConnectionCount(const Napi::CallbackInfo&);
+
   static PeerConnectionFactory* _default;
+  static PeerConnectionFactoryOptions _defaultOptions;
   static std::mutex _mutex;
   static int _references;
+  static bool _warmupReference;
 
   rtc::scoped_refptr<webrtc::PeerConnectionFactoryInterface> _factory;
   rtc::scoped_refptr<webrtc::AudioDeviceModule> _audioDeviceModule;
 
   std::unique_ptr<rtc::NetworkManager> _networkManager;
   std::unique_ptr<rtc::PacketSocketFactory> _socketFactory;
+
+  std::unique_ptr<SharedUdpSocketMux> _sharedUdpSocketMux;
+  std::unique_ptr<IceCandidatePool> _iceCandidatePool;
+
+  // Owned by _networkThread, if its socket server is an EpollSocketServer.
+  EpollSocketServer* _epollSocketServer = nullptr;
+
+  uint32_t _peerConnections = 0;
+
+  rtc::Event _initialized{true, false};
+  double _initializationTime = 0;
 };
 
+DECLARE_TO_AND_FROM_NAPI(PeerConnectionFactory*)
+
 }  // namespace node_webrtc
@@ -9,8 +9,13 @@
 
 #include <webrtc/api/stats/rtc_stats_report.h>
 
+#include "src/dictionaries/node_webrtc/rtc_stats_buffer.h"
 #include "src/dictionaries/webrtc/rtc_stats_report.h"  // IWYU pragma: keep
 
 void node_webrtc::RTCStatsCollector::OnStatsDelivered(const rtc::scoped_refptr<const webrtc::RTCStatsReport>& report) {
-  Resolve(report->Copy());
+  Resolve(FilteredRTCStatsReport {report->Copy(), _filter});
+}
+
+void node_webrtc::RTCStatsBufferCollector::OnStatsDelivered(const rtc::scoped_refptr<const webrtc::RTCStatsReport>& report) {
+  Resolve(RTCStatsBuffer::Create(*report, _filter.get()));
 }
@@ -7,6 +7,9 @@
  */
 #pragma once
 
+#include <memory>
+#include <utility>
+
 #include <node-addon-api/napi.h>
 #include <webrtc/api/scoped_refptr.h>
 #include <webrtc/api/stats/rtc_stats_collector_callback.h>
@@ -18,16 +21,42 @@ namespace webrtc { class RTCStatsReport; }
 
 namespace node_webrtc {
 
+struct RTCStatsFilter;
+
 class RTCStatsCollector
   : public PromiseCreator<RTCPeerConnection>
   , public webrtc::RTCStatsCollectorCallback {
  public:
   RTCStatsCollector(
       RTCPeerConnection* peer_connection,
-      Napi::Promise::Deferred deferred)
-    : PromiseCreator<RTCPeerConnection>(peer_connection, deferred) {}
+      Napi::Promise::Deferred deferred,
+      std::shared_ptr<const RTCStatsFilter> filter = nullptr)
+    : PromiseCreator<RTCPeerConnection>(peer_connection, deferred)
+    , _filter(std::move(filter)) {}
+
+  void OnStatsDelivered(const rtc::scoped_refptr<const webrtc::RTCStatsReport>&) override;
+
+ private:
+  std::shared_ptr<const RTCStatsFilter> _filter;
+};
+
+// RTCStatsBufferCollector resolves with an RTCStatsBuffer, built on the
+// signaling thread, instead of an RTCStatsReport.
+class RTCStatsBufferCollector
+  : public PromiseCreator<RTCPeerConnection>
+  , public webrtc::RTCStatsCollectorCallback {
+ public:
+  RTCStatsBufferCollector(
+      RTCPeerConnection* peer_connection,
+      Napi::Promise::Deferred deferred,
+      std::shared_ptr<const RTCStatsFilter> filter = nullptr)
+    : PromiseCreator<RTCPeerConnection>(peer_connection, deferred)
+    , _filter(std::move(filter)) {}
 
   void OnStatsDelivered(const rtc::scoped_refptr<const webrtc::RTCStatsReport>&) override;
+
+ private:
+  std::shared_ptr<const RTCStatsFilter> _filter;
 };
 
 }  // namespace node_webrtc;
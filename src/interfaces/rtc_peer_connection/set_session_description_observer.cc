@@ -17,10 +17,16 @@
 #include "src/node/error_factory.h"
 
 void node_webrtc::SetSessionDescriptionObserver::OnSuccess() {
+  // The operation may have been queued behind others, so the descriptions
+  // only change now, not when setLocalDescription or setRemoteDescription was
+  // called.
+  _peer_connection->InvalidateCachedDescriptions();
   Resolve(node_webrtc::Undefined());
 }
 
 void node_webrtc::SetSessionDescriptionObserver::OnFailure(webrtc::RTCError error) {
+  _peer_connection->InvalidateCachedDescriptions();
+
   auto someError = node_webrtc::From<node_webrtc::SomeError>(&error).FromValidation([](auto errors) {
     return node_webrtc::SomeError(errors[0]);
   });
@@ -25,11 +25,15 @@ class SetSessionDescriptionObserver
   SetSessionDescriptionObserver(
       RTCPeerConnection* peer_connection,
       Napi::Promise::Deferred deferred)
-    : PromiseCreator<RTCPeerConnection>(peer_connection, deferred) {}
+    : PromiseCreator<RTCPeerConnection>(peer_connection, deferred)
+    , _peer_connection(peer_connection) {}
 
   void OnSuccess() override;
 
   void OnFailure(webrtc::RTCError) override;
+
+ private:
+  RTCPeerConnection* _peer_connection;
 };
 
 }  // namespace node_webrtc
@@ -15,6 +15,7 @@
 
 #include <webrtc/api/scoped_refptr.h>
 
+#include "src/dictionaries/node_webrtc/legacy_stats.h"  // IWYU pragma: keep
 #include "src/dictionaries/node_webrtc/rtc_stats_response_init.h"  // IWYU pragma: keep
 
 void node_webrtc::StatsObserver::OnComplete(const webrtc::StatsReports& stats_reports) {
@@ -37,3 +38,21 @@ void node_webrtc::StatsObserver::OnComplete(const webrtc::StatsReports& stats_re
 
   Resolve(response);
 }
+
+void node_webrtc::FlatStatsObserver::OnComplete(const webrtc::StatsReports& stats_reports) {
+  auto reports = std::vector<LegacyStats>();
+  reports.reserve(stats_reports.size());
+  for (auto stats_report : stats_reports) {
+    LegacyStats report;
+    report.id = stats_report->id()->ToString();
+    report.type = stats_report->TypeToString();
+    report.timestamp = stats_report->timestamp();
+    report.stats.reserve(stats_report->values().size());
+    for (auto const& pair : stats_report->values()) {
+      report.stats.emplace_back(pair.second->display_name(), pair.second->ToString());
+    }
+    reports.push_back(std::move(report));
+  }
+
+  Resolve(reports);
+}
@@ -28,4 +28,18 @@ class StatsObserver
   void OnComplete(const webrtc::StatsReports&) override;
 };
 
+// FlatStatsObserver resolves with an Array of plain objects, one per report,
+// instead of an RTCStatsResponse.
+class FlatStatsObserver
+  : public PromiseCreator<RTCPeerConnection>
+  , public webrtc::StatsObserver {
+ public:
+  FlatStatsObserver(
+      RTCPeerConnection* peer_connection,
+      Napi::Promise::Deferred deferred)
+    : PromiseCreator(peer_connection, deferred) {}
+
+  void OnComplete(const webrtc::StatsReports&) override;
+};
+
 }  // namespace node_webrtc
@@ -0,0 +1,216 @@
+/* Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#include "src/interfaces/rtc_peer_connection/stats_subscription.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+#include <webrtc/api/stats/rtc_stats.h>
+#include <webrtc/api/stats/rtc_stats_report.h>
+#include <webrtc/rtc_base/checks.h>
+#include <webrtc/rtc_base/location.h>
+#include <webrtc/rtc_base/thread.h>
+
+#include "src/dictionaries/node_webrtc/rtc_stats_buffer.h"
+#include "src/dictionaries/webrtc/rtc_stats_member_interface.h"
+#include "src/interfaces/rtc_peer_connection.h"
+
+namespace node_webrtc {
+
+namespace {
+
+constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+
+const char* kRateMembers[] = {
+  "sendBitrate",
+  "receiveBitrate",
+  "packetLossFraction",
+  "frameRate"
+};
+
+bool IsSame(double a, double b) {
+  return a == b || (std::isnan(a) && std::isnan(b));
+}
+
+}  // namespace
+
+StatsSubscription::StatsSubscription(
+    RTCPeerConnection* target,
+    rtc::Thread* signalingThread,
+    rtc::scoped_refptr<webrtc::PeerConnectionInterface> peerConnection,
+    const RTCStatsSubscriptionOptions& options)
+  : _target(target)
+  , _signalingThread(signalingThread)
+  , _peerConnection(std::move(peerConnection))
+  , _options(options) {
+  _members.emplace_back("timestamp");
+  _columns.emplace("timestamp", 0);
+  for (auto& name : _options.filter.memberNames) {
+    if (_columns.emplace(name, _members.size()).second) {
+      _members.push_back(name);
+    }
+  }
+  _firstRateColumn = _members.size();
+  for (auto name : kRateMembers) {
+    _members.emplace_back(name);
+  }
+}
+
+StatsSubscription::~StatsSubscription() = default;
+
+void StatsSubscription::Start() {
+  _signalingThread->Post(RTC_FROM_HERE, this);
+}
+
+void StatsSubscription::Stop() {
+  RTC_DCHECK(!_signalingThread->IsCurrent());
+  _signalingThread->Invoke<void>(RTC_FROM_HERE, [this]() {
+    _stopped = true;
+    _signalingThread->Clear(this);
+    _peerConnection = nullptr;
+  });
+}
+
+void StatsSubscription::OnMessage(rtc::Message*) {
+  if (_stopped) {
+    return;
+  }
+  _peerConnection->GetStats(this);
+  _signalingThread->PostDelayed(RTC_FROM_HERE, static_cast<int>(_options.intervalMs), this);
+}
+
+void StatsSubscription::AddMembers(const webrtc::RTCStatsReport& report) {
+  for (const webrtc::RTCStats& stats : report) {
+    if (!_options.filter.HasType(stats.type())) {
+      continue;
+    }
+    for (const webrtc::RTCStatsMemberInterface* member : stats.Members()) {
+      double number;
+      if (!member->is_defined() || !GetNumber(*member, &number)) {
+        continue;
+      }
+      std::string name = member->name();
+      if (_columns.count(name)) {
+        continue;
+      }
+      // New members go before the rates, so that earlier columns keep their
+      // index.
+      auto column = _firstRateColumn++;
+      _columns.emplace(name, column);
+      _members.insert(_members.begin() + column, name);
+      for (auto& row : _rows) {
+        row.second.emitted.insert(row.second.emitted.begin() + column, kNaN);
+      }
+    }
+  }
+}
+
+void StatsSubscription::OnStatsDelivered(const rtc::scoped_refptr<const webrtc::RTCStatsReport>& report) {
+  if (_stopped) {
+    return;
+  }
+
+  // As in getStats, selecting no members selects every numeric member.
+  if (_options.filter.memberNames.empty()) {
+    AddMembers(*report);
+  }
+
+  auto stride = _members.size();
+  RTCStatsBuffer delta;
+  delta.members = _members;
+
+  std::unordered_map<std::string, Row> rows;
+  std::vector<double> current(stride);
+  for (const webrtc::RTCStats& stats : *report) {
+    if (!_options.filter.HasType(stats.type())) {
+      continue;
+    }
+
+    Row row;
+    row.timestampUs = stats.timestamp_us();
+    std::fill(std::begin(row.counters), std::end(row.counters), kNaN);
+    std::fill(current.begin(), current.end(), kNaN);
+    current[0] = stats.timestamp_us() / 1000.0;
+
+    for (const webrtc::RTCStatsMemberInterface* member : stats.Members()) {
+      double number;
+      if (!member->is_defined() || !GetNumber(*member, &number)) {
+        continue;
+      }
+      std::string name = member->name();
+      auto column = _columns.find(name);
+      if (column != _columns.end() && column->second) {
+        current[column->second] = number;
+      }
+      if (name == "bytesSent") {
+        row.counters[kBytesSent] = number;
+      } else if (name == "bytesReceived") {
+        row.counters[kBytesReceived] = number;
+      } else if (name == "packetsLost") {
+        row.counters[kPacketsLost] = number;
+      } else if (name == "packetsReceived") {
+        row.counters[kPacketsReceived] = number;
+      } else if (name == "framesDecoded") {
+        row.counters[kFramesDecoded] = number;
+      } else if (name == "framesEncoded") {
+        row.counters[kFramesEncoded] = number;
+      }
+    }
+
+    auto previous = _rows.find(stats.id());
+    if (previous != _rows.end()) {
+      auto seconds = (row.timestampUs - previous->second.timestampUs) / 1000000.0;
+      if (seconds > 0) {
+        auto& before = previous->second.counters;
+        auto& after = row.counters;
+        auto rates = current.begin() + _firstRateColumn;
+        rates[0] = 8 * (after[kBytesSent] - before[kBytesSent]) / seconds;
+        rates[1] = 8 * (after[kBytesReceived] - before[kBytesReceived]) / seconds;
+        auto lost = after[kPacketsLost] - before[kPacketsLost];
+        auto expected = lost + after[kPacketsReceived] - before[kPacketsReceived];
+        rates[2] = expected > 0 ? std::max(lost, 0.0) / expected : expected == 0 ? 0 : kNaN;
+        auto frames = std::isnan(after[kFramesDecoded])
+            ? after[kFramesEncoded] - before[kFramesEncoded]
+            : after[kFramesDecoded] - before[kFramesDecoded];
+        rates[3] = frames / seconds;
+      }
+    }
+
+    // Emit the values that changed since they were last emitted. NaN means
+    // "unchanged", so a member that becomes undefined keeps its last value.
+    auto changed = false;
+    auto values = delta.values.size();
+    delta.values.resize(values + stride, kNaN);
+    row.emitted = previous != _rows.end() ? previous->second.emitted : std::vector<double>(stride, kNaN);
+    for (size_t i = 1; i < stride; i++) {
+      if (!std::isnan(current[i]) && !IsSame(current[i], row.emitted[i])) {
+        delta.values[values + i] = current[i];
+        row.emitted[i] = current[i];
+        changed = true;
+      }
+    }
+    if (changed) {
+      delta.values[values] = current[0];
+      delta.ids.emplace_back(stats.id());
+      delta.types.emplace_back(stats.type());
+    } else {
+      delta.values.resize(values);
+    }
+
+    rows.emplace(stats.id(), std::move(row));
+  }
+  _rows = std::move(rows);
+
+  if (!delta.ids.empty()) {
+    _target->OnStats(std::move(delta));
+  }
+}
+
+}  // namespace node_webrtc
@@ -0,0 +1,106 @@
+/* Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <webrtc/api/peer_connection_interface.h>
+#include <webrtc/api/scoped_refptr.h>
+#include <webrtc/api/stats/rtc_stats_collector_callback.h>
+#include <webrtc/rtc_base/message_handler.h>
+
+#include "src/dictionaries/node_webrtc/rtc_stats_subscription_options.h"
+
+namespace rtc { class Thread; }
+namespace webrtc { class RTCStatsReport; }
+
+namespace node_webrtc {
+
+class RTCPeerConnection;
+
+/**
+ * A StatsSubscription collects an RTCPeerConnection's stats every
+ * `intervalMs` on the signaling thread, and passes the RTCPeerConnection an
+ * RTCStatsBuffer with only what changed since the last collection: rows are
+ * the stats objects with a changed value, and unchanged values are NaN.
+ *
+ * If no members are selected, every numeric member is, in the order they
+ * first appear. Besides the selected members, every row has the rates "sendBitrate" and
+ * "receiveBitrate" (bits per second, from bytesSent and bytesReceived),
+ * "packetLossFraction" (from packetsLost and packetsReceived), and "frameRate"
+ * (frames per second, from framesDecoded or framesEncoded), computed from the
+ * previous collection.
+ */
+class StatsSubscription
+  : public webrtc::RTCStatsCollectorCallback
+  , public rtc::MessageHandler {
+ public:
+  StatsSubscription(
+      RTCPeerConnection* target,
+      rtc::Thread* signalingThread,
+      rtc::scoped_refptr<webrtc::PeerConnectionInterface> peerConnection,
+      const RTCStatsSubscriptionOptions& options);
+
+  ~StatsSubscription() override;
+
+  /**
+   * Start collecting. May be called from any thread.
+   */
+  void Start();
+
+  /**
+   * Stop collecting. Once this returns, the target is no longer called. Must
+   * not be called on the signaling thread.
+   */
+  void Stop();
+
+  // rtc::MessageHandler
+  void OnMessage(rtc::Message*) override;
+
+  // webrtc::RTCStatsCollectorCallback
+  void OnStatsDelivered(const rtc::scoped_refptr<const webrtc::RTCStatsReport>&) override;
+
+ private:
+  enum Counter {
+    kBytesSent,
+    kBytesReceived,
+    kPacketsLost,
+    kPacketsReceived,
+    kFramesDecoded,
+    kFramesEncoded,
+    kNumCounters
+  };
+
+  struct Row {
+    int64_t timestampUs;
+    double counters[kNumCounters];
+    // The last value emitted in each column.
+    std::vector<double> emitted;
+  };
+
+  // Add a column for each numeric member of |report| without one.
+  void AddMembers(const webrtc::RTCStatsReport& report);
+
+  RTCPeerConnection* _target;
+  rtc::Thread* _signalingThread;
+  rtc::scoped_refptr<webrtc::PeerConnectionInterface> _peerConnection;
+  RTCStatsSubscriptionOptions _options;
+  bool _stopped = false;
+
+  std::vector<std::string> _members;
+  std::unordered_map<std::string, size_t> _columns;
+  size_t _firstRateColumn;
+
+  // The previous collection's rows, by stats object ID.
+  std::unordered_map<std::string, Row> _rows;
+};
+
+}  // namespace node_webrtc
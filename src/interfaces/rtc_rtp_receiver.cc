@@ -7,19 +7,24 @@
  */
 #include "src/interfaces/rtc_rtp_receiver.h"
 
+#include <memory>
+
 #include <webrtc/api/rtp_receiver_interface.h>
 
 #include "src/converters.h"
 #include "src/converters/arguments.h"
 #include "src/converters/interfaces.h"
 #include "src/converters/napi.h"
+#include "src/dictionaries/node_webrtc/rtc_stats_filter.h"
 #include "src/dictionaries/webrtc/rtp_capabilities.h"
 #include "src/dictionaries/webrtc/rtp_parameters.h"
 #include "src/dictionaries/webrtc/rtp_source.h"
 #include "src/enums/webrtc/media_type.h"
 #include "src/interfaces/media_stream_track.h"
 #include "src/interfaces/rtc_dtls_transport.h"
+#include "src/interfaces/rtc_peer_connection.h"
 #include "src/interfaces/rtc_peer_connection/peer_connection_factory.h"
+#include "src/node/error_factory.h"
 #include "src/node/utility.h"
 
 namespace node_webrtc {
@@ -53,6 +58,12 @@ RTCRtpReceiver::~RTCRtpReceiver() {
   wrap()->Release(this);
 }  // NOLINT
 
+void RTCRtpReceiver::SetPeerConnection(Napi::Object peerConnection) {
+  if (_peerConnection.IsEmpty()) {
+    _peerConnection = Napi::Weak(peerConnection);
+  }
+}
+
 Napi::Value RTCRtpReceiver::GetTrack(const Napi::CallbackInfo&) {
   return MediaStreamTrack::wrap()->GetOrCreate(_factory, _receiver->track())->Value();
 }
@@ -112,9 +123,24 @@ Napi::Value RTCRtpReceiver::GetSynchronizationSources(const Napi::CallbackInfo&
 }
 
 Napi::Value RTCRtpReceiver::GetStats(const Napi::CallbackInfo& info) {
-  CREATE_DEFERRED(info.Env(), deferred)
-  Reject(deferred, Napi::Error::New(info.Env(), "Not yet implemented; file a feature request against node-webrtc"));
-  return deferred.Promise();
+  auto env = info.Env();
+
+  CREATE_DEFERRED(env, deferred)
+
+  CONVERT_ARGS_OR_REJECT_AND_RETURN_NAPI(deferred, info, maybeFilter, Maybe<RTCStatsFilter>)
+  auto filter = maybeFilter.Map([](auto filter) {
+    return std::make_shared<const RTCStatsFilter>(filter);
+  }).FromMaybe(nullptr);
+
+  auto peerConnection = _peerConnection.Value();
+  if (peerConnection.IsEmpty()) {
+    Reject(deferred, ErrorFactory::CreateInvalidStateError(env, "RTCRtpReceiver does not belong to an RTCPeerConnection"));
+    return deferred.Promise();
+  }
+
+  RTCPeerConnection::Unwrap(peerConnection)->GetSelectedStats(deferred, _receiver, filter);
+
+  return deferred.Promise();  // NOLINT
 }
 
 Wrap <
@@ -38,6 +38,12 @@ class RTCRtpReceiver: public AsyncObjectWrap<RTCRtpReceiver> {
 
   static Napi::FunctionReference& constructor();
 
+  /**
+   * Remember the RTCPeerConnection this RTCRtpReceiver belongs to,
+   * weakly, so that getStats can collect through it.
+   */
+  void SetPeerConnection(Napi::Object peerConnection);
+
  private:
   static RTCRtpReceiver* Create(
       PeerConnectionFactory*,
@@ -55,6 +61,7 @@ class RTCRtpReceiver: public AsyncObjectWrap<RTCRtpReceiver> {
   Napi::Value GetStats(const Napi::CallbackInfo&);
 
   PeerConnectionFactory* _factory;
+  Napi::ObjectReference _peerConnection;
   rtc::scoped_refptr<webrtc::RtpReceiverInterface> _receiver;
 };
 
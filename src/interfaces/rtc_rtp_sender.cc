@@ -7,12 +7,15 @@
  */
 #include "src/interfaces/rtc_rtp_sender.h"
 
+#include <memory>
+
 #include <webrtc/api/rtp_parameters.h>
 
 #include "src/converters.h"
 #include "src/converters/arguments.h"
 #include "src/converters/interfaces.h"
 #include "src/converters/null.h"
+#include "src/dictionaries/node_webrtc/rtc_stats_filter.h"
 #include "src/dictionaries/webrtc/rtc_error.h"
 #include "src/dictionaries/webrtc/rtp_capabilities.h"
 #include "src/dictionaries/webrtc/rtp_parameters.h"
@@ -20,6 +23,7 @@
 #include "src/interfaces/media_stream_track.h"
 #include "src/interfaces/media_stream.h"
 #include "src/interfaces/rtc_dtls_transport.h"
+#include "src/interfaces/rtc_peer_connection.h"
 #include "src/interfaces/rtc_peer_connection/peer_connection_factory.h"
 #include "src/node/error_factory.h"
 #include "src/node/utility.h"
@@ -55,6 +59,12 @@ RTCRtpSender::~RTCRtpSender() {
   wrap()->Release(this);
 }
 
+void RTCRtpSender::SetPeerConnection(Napi::Object peerConnection) {
+  if (_peerConnection.IsEmpty()) {
+    _peerConnection = Napi::Weak(peerConnection);
+  }
+}
+
 Napi::Value RTCRtpSender::GetTrack(const Napi::CallbackInfo& info) {
   Napi::Value result = info.Env().Null();
   auto track = _sender->track();
@@ -108,9 +118,24 @@ Napi::Value RTCRtpSender::SetParameters(const Napi::CallbackInfo& info) {
 }
 
 Napi::Value RTCRtpSender::GetStats(const Napi::CallbackInfo& info) {
-  CREATE_DEFERRED(info.Env(), deffered)
-  Reject(deferred, Napi::Error::New(info.Env(), "Not yet implemented; file a feature request against node-webrtc"));
-  return deferred.Promise();
+  auto env = info.Env();
+
+  CREATE_DEFERRED(env, deferred)
+
+  CONVERT_ARGS_OR_REJECT_AND_RETURN_NAPI(deferred, info, maybeFilter, Maybe<RTCStatsFilter>)
+  auto filter = maybeFilter.Map([](auto filter) {
+    return std::make_shared<const RTCStatsFilter>(filter);
+  }).FromMaybe(nullptr);
+
+  auto peerConnection = _peerConnection.Value();
+  if (peerConnection.IsEmpty()) {
+    Reject(deferred, ErrorFactory::CreateInvalidStateError(env, "RTCRtpSender does not belong to an RTCPeerConnection"));
+    return deferred.Promise();
+  }
+
+  RTCPeerConnection::Unwrap(peerConnection)->GetSelectedStats(deferred, _sender, filter);
+
+  return deferred.Promise();  // NOLINT
 }
 
 Napi::Value RTCRtpSender::ReplaceTrack(const Napi::CallbackInfo& info) {
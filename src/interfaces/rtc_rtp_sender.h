@@ -40,6 +40,12 @@ class RTCRtpSender: public AsyncObjectWrap<RTCRtpSender> {
 
   static Napi::FunctionReference& constructor();
 
+  /**
+   * Remember the RTCPeerConnection this RTCRtpSender belongs to,
+   * weakly, so that getStats can collect through it.
+   */
+  void SetPeerConnection(Napi::Object peerConnection);
+
  private:
   static RTCRtpSender* Create(
       PeerConnectionFactory*,
@@ -58,6 +64,7 @@ class RTCRtpSender: public AsyncObjectWrap<RTCRtpSender> {
   Napi::Value SetStreams(const Napi::CallbackInfo&);
 
   PeerConnectionFactory* _factory;
+  Napi::ObjectReference _peerConnection;
   rtc::scoped_refptr<webrtc::RtpSenderInterface> _sender;
 };
 
@@ -58,12 +58,28 @@ Napi::Value RTCRtpTransceiver::GetMid(const Napi::CallbackInfo& info) {
   return result;
 }
 
+void RTCRtpTransceiver::SetPeerConnection(Napi::Object peerConnection) {
+  if (_peerConnection.IsEmpty()) {
+    _peerConnection = Napi::Weak(peerConnection);
+  }
+}
+
 Napi::Value RTCRtpTransceiver::GetSender(const Napi::CallbackInfo&) {
-  return RTCRtpSender::wrap()->GetOrCreate(_factory, _transceiver->sender())->Value();
+  auto sender = RTCRtpSender::wrap()->GetOrCreate(_factory, _transceiver->sender());
+  auto peerConnection = _peerConnection.Value();
+  if (!peerConnection.IsEmpty()) {
+    sender->SetPeerConnection(peerConnection);
+  }
+  return sender->Value();
 }
 
 Napi::Value RTCRtpTransceiver::GetReceiver(const Napi::CallbackInfo&) {
-  return RTCRtpReceiver::wrap()->GetOrCreate(_factory, _transceiver->receiver())->Value();
+  auto receiver = RTCRtpReceiver::wrap()->GetOrCreate(_factory, _transceiver->receiver());
+  auto peerConnection = _peerConnection.Value();
+  if (!peerConnection.IsEmpty()) {
+    receiver->SetPeerConnection(peerConnection);
+  }
+  return receiver->Value();
 }
 
 Napi::Value RTCRtpTransceiver::GetStopped(const Napi::CallbackInfo& info) {
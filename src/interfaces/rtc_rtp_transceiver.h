@@ -39,6 +39,12 @@ class RTCRtpTransceiver: public AsyncObjectWrap<RTCRtpTransceiver> {
 
   static Napi::FunctionReference& constructor();
 
+  /**
+   * Remember the RTCPeerConnection this RTCRtpTransceiver belongs to, weakly,
+   * and pass it on to its RTCRtpSender and RTCRtpReceiver.
+   */
+  void SetPeerConnection(Napi::Object peerConnection);
+
  private:
 
   static RTCRtpTransceiver* Create(
@@ -57,6 +63,7 @@ class RTCRtpTransceiver: public AsyncObjectWrap<RTCRtpTransceiver> {
   Napi::Value SetCodecPreferences(const Napi::CallbackInfo&);
 
   PeerConnectionFactory* _factory;
+  Napi::ObjectReference _peerConnection;
   rtc::scoped_refptr<webrtc::RtpTransceiverInterface> _transceiver;
 };
 
@@ -35,7 +35,7 @@ RTCSctpTransport::RTCSctpTransport(const Napi::CallbackInfo& info)
 
   _transport = std::move(transport);
 
-  _factory->_workerThread->Invoke<void>(RTC_FROM_HERE, [this]() {
+  _factory->_networkThread->Invoke<void>(RTC_FROM_HERE, [this]() {
     _dtls_transport = _transport->dtls_transport();
     _transport->RegisterObserver(this);
   });
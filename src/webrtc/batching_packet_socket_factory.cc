@@ -0,0 +1,566 @@
+/* Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#include "src/webrtc/batching_packet_socket_factory.h"
+
+#if defined(WEBRTC_LINUX)
+
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include <webrtc/rtc_base/async_packet_socket.h>
+#include <webrtc/rtc_base/buffer.h>
+#include <webrtc/rtc_base/location.h>
+#include <webrtc/rtc_base/logging.h>
+#include <webrtc/rtc_base/message_handler.h>
+#include <webrtc/rtc_base/network/sent_packet.h>
+#include <webrtc/rtc_base/physical_socket_server.h>
+#include <webrtc/rtc_base/socket_address.h>
+#include <webrtc/rtc_base/thread.h>
+#include <webrtc/rtc_base/time_utils.h>
+
+#include "src/webrtc/epoll_socket_server.h"
+
+// These are only defined by recent kernel headers.
+#ifndef SOL_UDP
+#define SOL_UDP 17
+#endif
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103
+#endif
+#ifndef UDP_GRO
+#define UDP_GRO 104
+#endif
+
+namespace node_webrtc {
+
+namespace {
+
+// The number of datagrams read or written per system call.
+constexpr size_t kBatchSize = 32;
+
+// With GRO, the kernel may coalesce datagrams into a buffer of up to 64 KB.
+constexpr size_t kMaxReceiveSize = 65535;
+
+// Limits on the datagrams coalesced into one GSO send.
+constexpr size_t kMaxGsoSegments = 64;
+constexpr size_t kMaxGsoBytes = 60000;
+
+// The number of recvmmsg calls per read event, so that one busy socket cannot
+// starve the rest.
+constexpr size_t kMaxReadsPerEvent = 4;
+
+constexpr size_t kControlSize = 64;
+
+}  // namespace
+
+struct BatchingPacketSocketFactory::ReceiveBuffers {
+  ReceiveBuffers(): data(kBatchSize * kMaxReceiveSize) {}
+
+  std::vector<uint8_t> data;
+  mmsghdr messages[kBatchSize];
+  iovec iovecs[kBatchSize];
+  sockaddr_storage addresses[kBatchSize];
+  uint8_t control[kBatchSize][kControlSize];
+};
+
+namespace {
+
+// BatchingAsyncUdpSocket owns its descriptor rather than wrapping an
+// rtc::PhysicalSocket, so that reading does not toggle the descriptor's read
+// events (and, with an EpollSocketServer, so that it is registered only once).
+class BatchingAsyncUdpSocket
+  : public rtc::AsyncPacketSocket
+  , public rtc::MessageHandler
+  , public rtc::Dispatcher
+  , public EpollSocketServer::Handler {
+ public:
+  BatchingAsyncUdpSocket(
+      rtc::Thread* thread,
+      EpollSocketServer* epoll,
+      int fd,
+      int family,
+      BatchingPacketSocketFactory::ReceiveBuffers* buffers)
+    : thread_(thread)
+    , epoll_(epoll)
+    , fd_(fd)
+    , family_(family)
+    , buffers_(buffers) {
+    // The socket is already bound, and its address is needed for every packet
+    // sent (see Flush), so look it up once.
+    sockaddr_storage storage = {};
+    socklen_t length = sizeof(storage);
+    if (!getsockname(fd_, reinterpret_cast<sockaddr*>(&storage), &length)) {
+      rtc::SocketAddressFromSockAddrStorage(storage, &local_address_);
+    }
+    int one = 1;
+    if (setsockopt(fd_, SOL_UDP, UDP_GRO, &one, sizeof(one))) {
+      RTC_LOG(LS_VERBOSE) << "UDP GRO is not supported: " << errno;
+    }
+    if (epoll_) {
+      registered_ = epoll_->Register(fd_, this);
+    }
+    if (!registered_) {
+      physical_socket_server()->Add(this);
+    }
+  }
+
+  ~BatchingAsyncUdpSocket() override {
+    Close();
+    thread_->Clear(this);
+  }
+
+  rtc::SocketAddress GetLocalAddress() const override {
+    return fd_ != -1 ? local_address_ : rtc::SocketAddress();
+  }
+
+  rtc::SocketAddress GetRemoteAddress() const override {
+    return rtc::SocketAddress();
+  }
+
+  int Send(const void* data, size_t size, const rtc::PacketOptions& options) override {
+    return SendTo(data, size, GetRemoteAddress(), options);
+  }
+
+  int SendTo(
+      const void* data,
+      size_t size,
+      const rtc::SocketAddress& address,
+      const rtc::PacketOptions& options) override {
+    if (fd_ == -1) {
+      SetError(EBADF);
+      return -1;
+    }
+    if (blocked_) {
+      SetError(EWOULDBLOCK);
+      return -1;
+    }
+    queue_.push_back({rtc::Buffer(static_cast<const uint8_t*>(data), size), address, options});
+    if (!flush_pending_) {
+      flush_pending_ = true;
+      thread_->Post(RTC_FROM_HERE, this);
+    }
+    return static_cast<int>(size);
+  }
+
+  int Close() override {
+    if (fd_ == -1) {
+      return 0;
+    }
+    if (registered_) {
+      epoll_->Unregister(fd_, this);
+    } else {
+      physical_socket_server()->Remove(this);
+    }
+    auto result = close(fd_);
+    fd_ = -1;
+    queue_.clear();
+    return result;
+  }
+
+  State GetState() const override {
+    return fd_ == -1 ? STATE_CLOSED : STATE_BOUND;
+  }
+
+  int GetOption(rtc::Socket::Option option, int* value) override;
+
+  int SetOption(rtc::Socket::Option option, int value) override;
+
+  int GetError() const override {
+    return error_;
+  }
+
+  void SetError(int error) override {
+    error_ = error;
+  }
+
+  // rtc::MessageHandler
+  void OnMessage(rtc::Message*) override {
+    Flush();
+  }
+
+  // rtc::Dispatcher, used when the network thread's socket server is an
+  // rtc::PhysicalSocketServer.
+  uint32_t GetRequestedEvents() override {
+    return rtc::DE_READ | (blocked_ ? rtc::DE_WRITE : 0);
+  }
+
+  void OnPreEvent(uint32_t) override {}
+
+  void OnEvent(uint32_t events, int) override {
+    if (events & rtc::DE_WRITE) {
+      OnWritable();
+    }
+    if (events & rtc::DE_READ && fd_ != -1) {
+      // Events are level-triggered, so there is no need to drain the socket.
+      OnReadable();
+    }
+  }
+
+  int GetDescriptor() override {
+    return fd_;
+  }
+
+  bool IsDescriptorClosed() override {
+    return false;
+  }
+
+  // EpollSocketServer::Handler
+  bool OnReadable() override;
+
+  void OnWritable() override;
+
+ private:
+  struct QueuedPacket {
+    rtc::Buffer data;
+    rtc::SocketAddress address;
+    rtc::PacketOptions options;
+  };
+
+  rtc::PhysicalSocketServer* physical_socket_server() const {
+    return static_cast<rtc::PhysicalSocketServer*>(thread_->socketserver());
+  }
+
+  bool GetSocketOption(rtc::Socket::Option option, int* level, int* name) const;
+  void SetBlocked(bool blocked);
+  void Flush();
+  void Deliver(const uint8_t* data, size_t size, size_t segment_size, const rtc::SocketAddress& address, int64_t timestamp);
+
+  rtc::Thread* thread_;
+  EpollSocketServer* epoll_;
+  int fd_;
+  int family_;
+  BatchingPacketSocketFactory::ReceiveBuffers* buffers_;
+  rtc::SocketAddress local_address_;
+
+  bool registered_ = false;
+  int error_ = 0;
+  std::vector<QueuedPacket> queue_;
+  bool flush_pending_ = false;
+  bool blocked_ = false;
+  bool gso_ = true;
+};
+
+bool BatchingAsyncUdpSocket::GetSocketOption(rtc::Socket::Option option, int* level, int* name) const {
+  auto ipv6 = family_ == AF_INET6;
+  switch (option) {
+    case rtc::Socket::OPT_RCVBUF:
+      *level = SOL_SOCKET;
+      *name = SO_RCVBUF;
+      return true;
+    case rtc::Socket::OPT_SNDBUF:
+      *level = SOL_SOCKET;
+      *name = SO_SNDBUF;
+      return true;
+    case rtc::Socket::OPT_DSCP:
+      *level = ipv6 ? IPPROTO_IPV6 : IPPROTO_IP;
+      *name = ipv6 ? IPV6_TCLASS : IP_TOS;
+      return true;
+    case rtc::Socket::OPT_DONTFRAGMENT:
+      *level = ipv6 ? IPPROTO_IPV6 : IPPROTO_IP;
+      *name = ipv6 ? IPV6_MTU_DISCOVER : IP_MTU_DISCOVER;
+      return true;
+    default:
+      return false;
+  }
+}
+
+int BatchingAsyncUdpSocket::GetOption(rtc::Socket::Option option, int* value) {
+  int level;
+  int name;
+  if (!GetSocketOption(option, &level, &name)) {
+    return -1;
+  }
+  socklen_t length = sizeof(*value);
+  if (getsockopt(fd_, level, name, value, &length)) {
+    SetError(errno);
+    return -1;
+  }
+  if (option == rtc::Socket::OPT_DSCP) {
+    *value >>= 2;
+  } else if (option == rtc::Socket::OPT_DONTFRAGMENT) {
+    *value = *value != IP_PMTUDISC_DONT;
+  }
+  return 0;
+}
+
+int BatchingAsyncUdpSocket::SetOption(rtc::Socket::Option option, int value) {
+  int level;
+  int name;
+  if (!GetSocketOption(option, &level, &name)) {
+    return -1;
+  }
+  if (option == rtc::Socket::OPT_DSCP) {
+    value <<= 2;
+  } else if (option == rtc::Socket::OPT_DONTFRAGMENT) {
+    value = value ? IP_PMTUDISC_DO : IP_PMTUDISC_DONT;
+  }
+  if (setsockopt(fd_, level, name, &value, sizeof(value))) {
+    SetError(errno);
+    return -1;
+  }
+  return 0;
+}
+
+void BatchingAsyncUdpSocket::SetBlocked(bool blocked) {
+  if (blocked_ == blocked) {
+    return;
+  }
+  blocked_ = blocked;
+  if (!registered_) {
+    physical_socket_server()->Update(this);
+  }
+}
+
+void BatchingAsyncUdpSocket::Flush() {
+  flush_pending_ = false;
+
+  // SignalSentPacket handlers may send (and queue) more packets.
+  auto queue = std::move(queue_);
+  queue_.clear();
+
+  mmsghdr messages[kBatchSize];
+  sockaddr_storage addresses[kBatchSize];
+  uint8_t control[kBatchSize][kControlSize];
+  std::vector<iovec> iovecs(queue.size());
+  std::pair<size_t, size_t> ranges[kBatchSize];
+
+  size_t next = 0;
+  while (next < queue.size()) {
+    memset(messages, 0, sizeof(messages));
+
+    // Build up to kBatchSize messages. With GSO, a message carries a run of
+    // datagrams to the same address, all the same size except for the last,
+    // which may be shorter.
+    size_t count = 0;
+    auto end = next;
+    auto coalesced = false;
+    while (count < kBatchSize && end < queue.size()) {
+      auto first = end;
+      auto segment_size = queue[first].data.size();
+      auto total = segment_size;
+      end++;
+      if (gso_) {
+        while (end < queue.size()
+            && end - first < kMaxGsoSegments
+            && queue[end].address == queue[first].address
+            && queue[end].data.size() <= segment_size
+            && total + queue[end].data.size() <= kMaxGsoBytes) {
+          auto size = queue[end].data.size();
+          total += size;
+          end++;
+          if (size < segment_size) {
+            break;
+          }
+        }
+      }
+
+      for (auto i = first; i < end; i++) {
+        iovecs[i].iov_base = queue[i].data.data();
+        iovecs[i].iov_len = queue[i].data.size();
+      }
+
+      auto& header = messages[count].msg_hdr;
+      header.msg_name = &addresses[count];
+      header.msg_namelen = queue[first].address.ToSockAddrStorage(&addresses[count]);
+      header.msg_iov = &iovecs[first];
+      header.msg_iovlen = end - first;
+      if (end - first > 1) {
+        coalesced = true;
+        header.msg_control = control[count];
+        header.msg_controllen = CMSG_SPACE(sizeof(uint16_t));
+        auto cmsg = CMSG_FIRSTHDR(&header);
+        cmsg->cmsg_level = SOL_UDP;
+        cmsg->cmsg_type = UDP_SEGMENT;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+        auto segment = static_cast<uint16_t>(segment_size);
+        memcpy(CMSG_DATA(cmsg), &segment, sizeof(segment));
+      }
+
+      ranges[count] = {first, end};
+      count++;
+    }
+
+    auto sent = sendmmsg(fd_, messages, count, 0);
+    if (sent < 0) {
+      auto error = errno;
+      if (error == EAGAIN || error == EWOULDBLOCK) {
+        // SendTo already reported the rest as sent, so keep them for
+        // OnWritable, and refuse new ones until then.
+        SetBlocked(true);
+        queue.erase(queue.begin(), queue.begin() + next);
+        queue.insert(queue.end(), std::make_move_iterator(queue_.begin()), std::make_move_iterator(queue_.end()));
+        queue_ = std::move(queue);
+        return;
+      } else if (gso_ && (error == EIO || error == EINVAL) && coalesced) {
+        RTC_LOG(LS_INFO) << "UDP GSO failed (" << error << "); falling back to sendmmsg";
+        gso_ = false;
+        continue;
+      }
+      RTC_LOG(LS_VERBOSE) << "sendmmsg failed: " << error;
+      SetError(error);
+      next = ranges[0].second;
+      continue;
+    }
+
+    auto now = rtc::TimeMillis();
+    for (auto i = 0; i < sent; i++) {
+      for (auto j = ranges[i].first; j < ranges[i].second; j++) {
+        const auto& packet = queue[j];
+        rtc::SentPacket sent_packet(packet.options.packet_id, now, packet.options.info_signaled_after_sent);
+        rtc::CopySocketInformationToPacketInfo(packet.data.size(), *this, true, &sent_packet.info);
+        SignalSentPacket(this, sent_packet);
+      }
+    }
+    next = ranges[sent - 1].second;
+  }
+}
+
+bool BatchingAsyncUdpSocket::OnReadable() {
+  auto& buffers = *buffers_;
+
+  for (size_t read = 0; read < kMaxReadsPerEvent; read++) {
+    for (size_t i = 0; i < kBatchSize; i++) {
+      buffers.iovecs[i].iov_base = buffers.data.data() + i * kMaxReceiveSize;
+      buffers.iovecs[i].iov_len = kMaxReceiveSize;
+      auto& header = buffers.messages[i].msg_hdr;
+      header.msg_name = &buffers.addresses[i];
+      header.msg_namelen = sizeof(buffers.addresses[i]);
+      header.msg_iov = &buffers.iovecs[i];
+      header.msg_iovlen = 1;
+      header.msg_control = buffers.control[i];
+      header.msg_controllen = kControlSize;
+      header.msg_flags = 0;
+      buffers.messages[i].msg_len = 0;
+    }
+
+    auto received = recvmmsg(fd_, buffers.messages, kBatchSize, MSG_DONTWAIT, nullptr);
+    if (received <= 0) {
+      return received == 0 || errno != EINTR;
+    }
+
+    auto now = rtc::TimeMicros();
+    for (auto i = 0; i < received; i++) {
+      auto& header = buffers.messages[i].msg_hdr;
+      if (header.msg_flags & MSG_TRUNC) {
+        continue;
+      }
+
+      size_t segment_size = 0;
+      for (auto cmsg = CMSG_FIRSTHDR(&header); cmsg; cmsg = CMSG_NXTHDR(&header, cmsg)) {
+        if (cmsg->cmsg_level == SOL_UDP && cmsg->cmsg_type == UDP_GRO) {
+          int gso_size = 0;
+          memcpy(&gso_size, CMSG_DATA(cmsg), sizeof(gso_size));
+          segment_size = static_cast<size_t>(gso_size);
+        }
+      }
+
+      rtc::SocketAddress address;
+      rtc::SocketAddressFromSockAddrStorage(buffers.addresses[i], &address);
+      Deliver(static_cast<const uint8_t*>(buffers.iovecs[i].iov_base), buffers.messages[i].msg_len,
+          segment_size, address, now);
+      // A handler may have closed the socket.
+      if (fd_ == -1) {
+        return true;
+      }
+    }
+
+    if (static_cast<size_t>(received) < kBatchSize) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void BatchingAsyncUdpSocket::Deliver(
+    const uint8_t* data,
+    size_t size,
+    size_t segment_size,
+    const rtc::SocketAddress& address,
+    int64_t timestamp) {
+  if (!segment_size) {
+    segment_size = size;
+  }
+  for (size_t offset = 0; offset < size; offset += segment_size) {
+    auto length = std::min(segment_size, size - offset);
+    SignalReadPacket(this, reinterpret_cast<const char*>(data + offset), length, address, timestamp);
+  }
+}
+
+void BatchingAsyncUdpSocket::OnWritable() {
+  if (!blocked_) {
+    return;
+  }
+  SetBlocked(false);
+  Flush();
+  if (!blocked_) {
+    SignalReadyToSend(this);
+  }
+}
+
+int BindSocket(
+    int fd,
+    const rtc::SocketAddress& address,
+    uint16_t min_port,
+    uint16_t max_port) {
+  auto bind_to = [fd](const rtc::SocketAddress& address) {
+    sockaddr_storage storage = {};
+    auto length = address.ToSockAddrStorage(&storage);
+    return bind(fd, reinterpret_cast<sockaddr*>(&storage), length);
+  };
+  int result = -1;
+  if (min_port == 0 && max_port == 0) {
+    result = bind_to(address);
+  } else {
+    for (int port = min_port; result < 0 && port <= max_port; port++) {
+      result = bind_to(rtc::SocketAddress(address.ipaddr(), port));
+    }
+  }
+  return result;
+}
+
+}  // namespace
+
+BatchingPacketSocketFactory::BatchingPacketSocketFactory(rtc::Thread* thread, EpollSocketServer* epoll)
+  : rtc::BasicPacketSocketFactory(thread)
+  , thread_(thread)
+  , epoll_(epoll)
+  , buffers_(new ReceiveBuffers()) {}
+
+BatchingPacketSocketFactory::~BatchingPacketSocketFactory() = default;
+
+rtc::AsyncPacketSocket* BatchingPacketSocketFactory::CreateUdpSocket(
+    const rtc::SocketAddress& address,
+    uint16_t min_port,
+    uint16_t max_port) {
+  auto family = address.family();
+  auto fd = socket(family, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  if (fd == -1) {
+    RTC_LOG(LS_ERROR) << "UDP socket creation failed with error " << errno;
+    return nullptr;
+  }
+  if (BindSocket(fd, address, min_port, max_port) < 0) {
+    RTC_LOG(LS_ERROR) << "UDP bind failed with error " << errno;
+    close(fd);
+    return nullptr;
+  }
+  return new BatchingAsyncUdpSocket(thread_, epoll_, fd, family, buffers_.get());
+}
+
+}  // namespace node_webrtc
+
+#endif  // WEBRTC_LINUX
@@ -0,0 +1,62 @@
+/* Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#pragma once
+
+#if defined(WEBRTC_LINUX)
+
+#include <cstdint>
+#include <memory>
+
+#include <webrtc/p2p/base/basic_packet_socket_factory.h>
+
+namespace rtc {
+
+class AsyncPacketSocket;
+class SocketAddress;
+class Thread;
+
+}  // namespace rtc
+
+namespace node_webrtc {
+
+class EpollSocketServer;
+
+// BatchingPacketSocketFactory creates UDP sockets which read datagrams in
+// batches with recvmmsg(2) and write them in batches with sendmmsg(2), using
+// UDP generic receive and segmentation offload (GRO and GSO) where the kernel
+// supports them. Datagrams sent while handling one message on |thread| are
+// written together once it returns. TCP sockets are created by
+// rtc::BasicPacketSocketFactory, as usual.
+//
+// |thread| must be the network thread, and its socket server an
+// rtc::PhysicalSocketServer. If that is the EpollSocketServer |epoll|, UDP
+// sockets are registered with its edge-triggered set.
+class BatchingPacketSocketFactory : public rtc::BasicPacketSocketFactory {
+ public:
+  explicit BatchingPacketSocketFactory(rtc::Thread* thread, EpollSocketServer* epoll = nullptr);
+
+  ~BatchingPacketSocketFactory() override;
+
+  rtc::AsyncPacketSocket* CreateUdpSocket(
+      const rtc::SocketAddress& address,
+      uint16_t min_port,
+      uint16_t max_port) override;
+
+  // Receive buffers, shared by every socket since they are only used on
+  // |thread_|.
+  struct ReceiveBuffers;
+
+ private:
+  rtc::Thread* thread_;
+  EpollSocketServer* epoll_;
+  std::unique_ptr<ReceiveBuffers> buffers_;
+};
+
+}  // namespace node_webrtc
+
+#endif  // WEBRTC_LINUX
@@ -0,0 +1,160 @@
+/* Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#include "src/webrtc/caching_network_manager.h"
+
+#include <algorithm>
+#include <utility>
+
+#include <webrtc/rtc_base/checks.h>
+#include <webrtc/rtc_base/location.h>
+#include <webrtc/rtc_base/logging.h>
+#include <webrtc/rtc_base/thread.h>
+
+namespace node_webrtc {
+
+namespace {
+
+enum : uint32_t {
+  kRefresh,
+  kUpdate,
+  kSignalNetworks
+};
+
+bool MatchesInterfaceName(const std::string& pattern, const std::string& name) {
+  if (!pattern.empty() && pattern.back() == '*') {
+    return name.compare(0, pattern.size() - 1, pattern, 0, pattern.size() - 1) == 0;
+  }
+  return name == pattern;
+}
+
+bool MatchesAnyInterfaceName(const std::vector<std::string>& patterns, const std::string& name) {
+  return std::any_of(patterns.begin(), patterns.end(), [&name](const std::string& pattern) {
+    return MatchesInterfaceName(pattern, name);
+  });
+}
+
+void DeleteNetworks(rtc::NetworkManager::NetworkList* networks) {
+  for (auto network : *networks) {
+    delete network;
+  }
+  networks->clear();
+}
+
+}  // namespace
+
+// rtc::BasicNetworkManager knows how to enumerate networks, but only exposes
+// it to subclasses.
+class CachingNetworkManager::Enumerator : public rtc::BasicNetworkManager {
+ public:
+  bool Enumerate(NetworkList* networks) const {
+    return CreateNetworks(false, networks);
+  }
+};
+
+CachingNetworkManager::CachingNetworkManager(
+    rtc::Thread* network_thread,
+    std::vector<std::string> allowlist,
+    std::vector<std::string> denylist,
+    uint32_t refresh_interval_ms,
+    const std::string& thread_name)
+  : network_thread_(network_thread)
+  , refresh_thread_(rtc::Thread::Create())
+  , enumerator_(new Enumerator())
+  , allowlist_(std::move(allowlist))
+  , denylist_(std::move(denylist))
+  , refresh_interval_ms_(refresh_interval_ms) {
+  refresh_thread_->SetName(thread_name, nullptr);
+  refresh_thread_->Start();
+  refresh_thread_->Post(RTC_FROM_HERE, this, kRefresh);
+}
+
+CachingNetworkManager::~CachingNetworkManager() {
+  RTC_DCHECK(network_thread_->IsCurrent());
+  refresh_thread_->Stop();
+  network_thread_->Clear(this);
+  DeleteNetworks(&pending_);
+}
+
+void CachingNetworkManager::StartUpdating() {
+  RTC_DCHECK(network_thread_->IsCurrent());
+  start_count_++;
+  // Otherwise, the first Update signals.
+  if (sent_first_update_) {
+    network_thread_->Post(RTC_FROM_HERE, this, kSignalNetworks);
+  }
+}
+
+void CachingNetworkManager::StopUpdating() {
+  RTC_DCHECK(network_thread_->IsCurrent());
+  if (start_count_) {
+    start_count_--;
+  }
+}
+
+void CachingNetworkManager::OnMessage(rtc::Message* message) {
+  switch (message->message_id) {
+    case kRefresh:
+      Refresh();
+      break;
+    case kUpdate:
+      Update();
+      break;
+    case kSignalNetworks:
+      SignalNetworksChanged();
+      break;
+  }
+}
+
+bool CachingNetworkManager::IsAllowed(const rtc::Network& network) const {
+  auto& name = network.name();
+  return (allowlist_.empty() || MatchesAnyInterfaceName(allowlist_, name))
+      && !MatchesAnyInterfaceName(denylist_, name);
+}
+
+void CachingNetworkManager::Refresh() {
+  NetworkList networks;
+  if (enumerator_->Enumerate(&networks)) {
+    auto allowed = std::stable_partition(networks.begin(), networks.end(), [this](rtc::Network* network) {
+      return IsAllowed(*network);
+    });
+    for (auto it = allowed; it != networks.end(); it++) {
+      delete *it;
+    }
+    networks.erase(allowed, networks.end());
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    DeleteNetworks(&pending_);
+    pending_ = std::move(networks);
+    if (!has_pending_) {
+      has_pending_ = true;
+      network_thread_->Post(RTC_FROM_HERE, this, kUpdate);
+    }
+  } else {
+    RTC_LOG(LS_WARNING) << "Failed to enumerate networks";
+  }
+  refresh_thread_->PostDelayed(RTC_FROM_HERE, refresh_interval_ms_, this, kRefresh);
+}
+
+void CachingNetworkManager::Update() {
+  NetworkList networks;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    networks = std::move(pending_);
+    pending_.clear();
+    has_pending_ = false;
+  }
+  // MergeNetworkList takes ownership of |networks|.
+  bool changed = false;
+  MergeNetworkList(networks, &changed);
+  if (changed || !sent_first_update_) {
+    sent_first_update_ = true;
+    SignalNetworksChanged();
+  }
+}
+
+}  // namespace node_webrtc
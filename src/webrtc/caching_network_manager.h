@@ -0,0 +1,83 @@
+/* Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <webrtc/rtc_base/message_handler.h>
+#include <webrtc/rtc_base/network.h>
+
+namespace rtc {
+
+class Thread;
+
+}  // namespace rtc
+
+namespace node_webrtc {
+
+// CachingNetworkManager enumerates the host's network interfaces on a
+// background thread, every |refresh_interval_ms|, and keeps the result.
+// rtc::BasicNetworkManager instead enumerates them on the network thread,
+// whenever the first port allocator session starts updating, which can take
+// seconds on hosts with hundreds of (virtual) interfaces; here, starting to
+// update just signals the cached networks.
+//
+// Interfaces are gathered only if their name matches |allowlist| (when
+// non-empty) and does not match |denylist|. A pattern ending in "*" matches
+// names starting with the rest of the pattern.
+//
+// CachingNetworkManager must be used and destroyed on |network_thread|.
+class CachingNetworkManager
+  : public rtc::NetworkManagerBase
+  , public rtc::MessageHandler {
+ public:
+  CachingNetworkManager(
+      rtc::Thread* network_thread,
+      std::vector<std::string> allowlist,
+      std::vector<std::string> denylist,
+      uint32_t refresh_interval_ms,
+      const std::string& thread_name);
+
+  ~CachingNetworkManager() override;
+
+  // rtc::NetworkManager
+  void StartUpdating() override;
+  void StopUpdating() override;
+
+  // rtc::MessageHandler
+  void OnMessage(rtc::Message* message) override;
+
+ private:
+  class Enumerator;
+
+  bool IsAllowed(const rtc::Network& network) const;
+  void Refresh();
+  void Update();
+
+  rtc::Thread* network_thread_;
+  std::unique_ptr<rtc::Thread> refresh_thread_;
+  std::unique_ptr<Enumerator> enumerator_;
+  std::vector<std::string> allowlist_;
+  std::vector<std::string> denylist_;
+  uint32_t refresh_interval_ms_;
+
+  // Networks enumerated on |refresh_thread_|, waiting to be merged on
+  // |network_thread_|.
+  std::mutex mutex_;
+  NetworkList pending_;
+  bool has_pending_ = false;
+
+  int start_count_ = 0;
+  bool sent_first_update_ = false;
+};
+
+}  // namespace node_webrtc
@@ -0,0 +1,165 @@
+/* Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#include "src/webrtc/epoll_socket_server.h"
+
+#if defined(WEBRTC_LINUX)
+
+#include <sys/epoll.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+
+#include <webrtc/rtc_base/checks.h>
+#include <webrtc/rtc_base/logging.h>
+#include <webrtc/rtc_base/time_utils.h>
+
+namespace node_webrtc {
+
+namespace {
+
+constexpr int kMaxEvents = 128;
+
+}  // namespace
+
+// The EpollDispatcher is how the rtc::PhysicalSocketServer learns that
+// something in the edge-triggered set is ready: an epoll descriptor is itself
+// readable whenever it has events to report.
+class EpollSocketServer::EpollDispatcher : public rtc::Dispatcher {
+ public:
+  explicit EpollDispatcher(EpollSocketServer* server): server_(server) {}
+
+  uint32_t GetRequestedEvents() override {
+    return rtc::DE_READ;
+  }
+
+  void OnPreEvent(uint32_t) override {}
+
+  void OnEvent(uint32_t, int) override {
+    server_->wakeups_++;
+    server_->ProcessEvents();
+  }
+
+  int GetDescriptor() override {
+    return server_->epoll_fd_;
+  }
+
+  bool IsDescriptorClosed() override {
+    return false;
+  }
+
+ private:
+  EpollSocketServer* server_;
+};
+
+EpollSocketServer::EpollSocketServer()
+  : epoll_fd_(epoll_create1(EPOLL_CLOEXEC))
+  , dispatcher_(new EpollDispatcher(this)) {
+  RTC_CHECK_NE(epoll_fd_, -1);
+  Add(dispatcher_.get());
+}
+
+EpollSocketServer::~EpollSocketServer() {
+  RTC_DCHECK(handlers_.empty());
+  Remove(dispatcher_.get());
+  close(epoll_fd_);
+}
+
+bool EpollSocketServer::Register(int fd, Handler* handler) {
+  epoll_event event = {};
+  event.events = EPOLLIN | EPOLLOUT | EPOLLET;
+  event.data.ptr = handler;
+  if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event)) {
+    RTC_LOG(LS_ERROR) << "epoll_ctl(EPOLL_CTL_ADD) failed: " << errno;
+    return false;
+  }
+  handlers_.insert(handler);
+  return true;
+}
+
+void EpollSocketServer::Unregister(int fd, Handler* handler) {
+  epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+  handlers_.erase(handler);
+  pending_.erase(std::remove(pending_.begin(), pending_.end(), handler), pending_.end());
+}
+
+EpollSocketServer::Stats EpollSocketServer::GetStats() const {
+  return {wakeups_.load(), iterations_.load(), events_.load(), time_us_.load()};
+}
+
+bool EpollSocketServer::Wait(int cms, bool process_io) {
+  // Handlers which were not drained must run again without waiting.
+  if (process_io && !pending_.empty()) {
+    cms = 0;
+  }
+  auto result = rtc::PhysicalSocketServer::Wait(cms, process_io);
+  if (process_io && !pending_.empty()) {
+    ProcessPending();
+  }
+  return result;
+}
+
+void EpollSocketServer::ProcessEvents() {
+  auto start = rtc::TimeMicros();
+
+  epoll_event events[kMaxEvents];
+  auto count = epoll_wait(epoll_fd_, events, kMaxEvents, 0);
+  auto was_pending = !pending_.empty();
+  for (auto i = 0; i < count; i++) {
+    auto handler = static_cast<Handler*>(events[i].data.ptr);
+    // A handler may have been unregistered by an earlier one.
+    if (!handlers_.count(handler)) {
+      continue;
+    }
+    if ((events[i].events & (EPOLLOUT | EPOLLERR)) != 0) {
+      handler->OnWritable();
+      if (!handlers_.count(handler)) {
+        continue;
+      }
+    }
+    if ((events[i].events & (EPOLLIN | EPOLLERR | EPOLLHUP)) != 0
+        && !handler->OnReadable()
+        && handlers_.count(handler)
+        && std::find(pending_.begin(), pending_.end(), handler) == pending_.end()) {
+      pending_.push_back(handler);
+    }
+  }
+
+  // This runs inside rtc::PhysicalSocketServer::Wait, which only returns (and
+  // lets Wait process pending handlers) once something else wakes it, so wake
+  // it now rather than leaving undrained sockets unread until then.
+  if (!was_pending && !pending_.empty()) {
+    WakeUp();
+  }
+
+  if (count > 0) {
+    iterations_++;
+    events_ += count;
+    time_us_ += rtc::TimeMicros() - start;
+  }
+}
+
+void EpollSocketServer::ProcessPending() {
+  auto start = rtc::TimeMicros();
+
+  auto pending = std::move(pending_);
+  pending_.clear();
+  for (auto handler : pending) {
+    if (handlers_.count(handler) && !handler->OnReadable() && handlers_.count(handler)) {
+      pending_.push_back(handler);
+    }
+  }
+
+  iterations_++;
+  events_ += pending.size();
+  time_us_ += rtc::TimeMicros() - start;
+}
+
+}  // namespace node_webrtc
+
+#endif  // WEBRTC_LINUX
@@ -0,0 +1,89 @@
+/* Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#pragma once
+
+#if defined(WEBRTC_LINUX)
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <unordered_set>
+#include <vector>
+
+#include <webrtc/rtc_base/physical_socket_server.h>
+
+namespace node_webrtc {
+
+// EpollSocketServer is an rtc::PhysicalSocketServer with an additional,
+// edge-triggered epoll set. Descriptors registered with it are added to that
+// set once, and never modified again, so unlike rtc::PhysicalSocket, reading
+// does not cost an epoll_ctl(2) per datagram. The set itself is registered
+// with the rtc::PhysicalSocketServer as a single Dispatcher, so every other
+// socket and the thread's message queue work as usual.
+//
+// EpollSocketServer also counts the times the edge-triggered set woke it up,
+// and measures the time spent handling the edge-triggered events.
+class EpollSocketServer : public rtc::PhysicalSocketServer {
+ public:
+  class Handler {
+   public:
+    virtual ~Handler() = default;
+
+    // Called when the descriptor becomes readable. Since events are
+    // edge-triggered, return false if the descriptor was not drained, so that
+    // OnReadable is called again on the next iteration.
+    virtual bool OnReadable() = 0;
+
+    // Called when the descriptor becomes writable.
+    virtual void OnWritable() = 0;
+  };
+
+  struct Stats {
+    uint64_t wakeups;
+    uint64_t iterations;
+    uint64_t events;
+    int64_t time_us;
+  };
+
+  EpollSocketServer();
+
+  ~EpollSocketServer() override;
+
+  // Register |fd| for edge-triggered read and write events. Must be called on
+  // the thread running this socket server.
+  bool Register(int fd, Handler* handler);
+
+  // Unregister |fd|. Must be called on the thread running this socket server.
+  void Unregister(int fd, Handler* handler);
+
+  // Safe to call from any thread.
+  Stats GetStats() const;
+
+  // rtc::SocketServer
+  bool Wait(int cms, bool process_io) override;
+
+ private:
+  class EpollDispatcher;
+
+  void ProcessEvents();
+  void ProcessPending();
+
+  int epoll_fd_;
+  std::unique_ptr<EpollDispatcher> dispatcher_;
+  std::unordered_set<Handler*> handlers_;
+  std::vector<Handler*> pending_;
+
+  std::atomic<uint64_t> wakeups_{0};
+  std::atomic<uint64_t> iterations_{0};
+  std::atomic<uint64_t> events_{0};
+  std::atomic<int64_t> time_us_{0};
+};
+
+}  // namespace node_webrtc
+
+#endif  // WEBRTC_LINUX
@@ -0,0 +1,271 @@
+/* Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#include "src/webrtc/ice_candidate_pool.h"
+
+#include <algorithm>
+
+#include <webrtc/p2p/base/port_allocator.h>
+#include <webrtc/p2p/client/basic_port_allocator.h>
+#include <webrtc/rtc_base/checks.h>
+#include <webrtc/rtc_base/location.h>
+#include <webrtc/rtc_base/thread.h>
+#include <webrtc/rtc_base/time_utils.h>
+
+namespace node_webrtc {
+
+namespace {
+
+// How often expired sessions are looked for, relative to the TTL.
+constexpr int kExpireChecksPerTtl = 4;
+constexpr int kMinExpireCheckIntervalMs = 100;
+
+// Expired sessions are taken from the pool and discarded, and taking a session
+// requires ICE credentials.
+constexpr char kExpiredUfrag[] = "expired";
+constexpr char kExpiredPwd[] = "expiredexpiredexpiredex";
+
+}  // namespace
+
+// A PoolAllocator gathers the pool's sessions for one configuration.
+class IceCandidatePool::PoolAllocator : public cricket::BasicPortAllocator {
+ public:
+  PoolAllocator(
+      rtc::NetworkManager* network_manager,
+      rtc::PacketSocketFactory* socket_factory)
+    : cricket::BasicPortAllocator(network_manager, socket_factory) {}
+
+  cricket::PortAllocatorSession* CreateSessionInternal(
+      const std::string& content_name,
+      int component,
+      const std::string& ice_ufrag,
+      const std::string& ice_pwd) override;
+};
+
+// Keeps a claimed session's PoolAllocator alive until after the session is
+// destroyed, since BasicPortAllocatorSession reads its configuration from it.
+struct IceCandidatePool::PoolAllocatorOwner {
+  std::shared_ptr<PoolAllocator> owned_allocator;
+};
+
+// A PooledSession is gathered ahead of time and later claimed by an
+// RTCPeerConnection's P2PTransportChannel. The channel only replays the
+// ports and candidates of sessions taken with PortAllocator::TakePooledSession,
+// so a claimed session replays them itself when the channel starts it.
+class IceCandidatePool::PooledSession
+  : private PoolAllocatorOwner
+  , public cricket::BasicPortAllocatorSession {
+ public:
+  PooledSession(
+      PoolAllocator* allocator,
+      const std::string& content_name,
+      int component,
+      const std::string& ice_ufrag,
+      const std::string& ice_pwd)
+    : cricket::BasicPortAllocatorSession(allocator, content_name, component, ice_ufrag, ice_pwd) {}
+
+  void Claim(std::shared_ptr<PoolAllocator> allocator) {
+    owned_allocator = std::move(allocator);
+  }
+
+  void StartGettingPorts() override {
+    if (!owned_allocator || !started_) {
+      started_ = true;
+      cricket::BasicPortAllocatorSession::StartGettingPorts();
+      return;
+    }
+    // Equivalent ports are never allocated twice, so the ports this session
+    // gathered while pooled are only ever announced here.
+    for (auto port : ReadyPorts()) {
+      SignalPortReady(this, port);
+    }
+    auto candidates = ReadyCandidates();
+    if (!candidates.empty()) {
+      SignalCandidatesReady(this, candidates);
+    }
+    if (CandidatesAllocationDone()) {
+      SignalCandidatesAllocationDone(this);
+    }
+  }
+
+ private:
+  bool started_ = false;
+};
+
+cricket::PortAllocatorSession* IceCandidatePool::PoolAllocator::CreateSessionInternal(
+    const std::string& content_name,
+    int component,
+    const std::string& ice_ufrag,
+    const std::string& ice_pwd) {
+  return new PooledSession(this, content_name, component, ice_ufrag, ice_pwd);
+}
+
+// A PooledPortAllocator is an RTCPeerConnection's port allocator. It claims
+// sessions from the IceCandidatePool before creating its own.
+class IceCandidatePool::PooledPortAllocator : public cricket::BasicPortAllocator {
+ public:
+  PooledPortAllocator(
+      IceCandidatePool* pool,
+      rtc::NetworkManager* network_manager,
+      rtc::PacketSocketFactory* socket_factory)
+    : cricket::BasicPortAllocator(network_manager, socket_factory)
+    , pool_(pool) {}
+
+ protected:
+  cricket::PortAllocatorSession* CreateSessionInternal(
+      const std::string& content_name,
+      int component,
+      const std::string& ice_ufrag,
+      const std::string& ice_pwd) override {
+    auto session = pool_->Take(*this, content_name, component, ice_ufrag, ice_pwd);
+    if (session) {
+      return session.release();
+    }
+    return cricket::BasicPortAllocator::CreateSessionInternal(content_name, component, ice_ufrag, ice_pwd);
+  }
+
+ private:
+  IceCandidatePool* pool_;
+};
+
+IceCandidatePool::IceCandidatePool(
+    rtc::Thread* network_thread,
+    rtc::NetworkManager* network_manager,
+    rtc::PacketSocketFactory* socket_factory,
+    int size,
+    int ttl_ms)
+  : network_thread_(network_thread)
+  , network_manager_(network_manager)
+  , socket_factory_(socket_factory)
+  , size_(size)
+  , ttl_ms_(ttl_ms) {
+  RTC_DCHECK(network_thread_->IsCurrent());
+  allocator_ = CreateAllocator();
+}
+
+IceCandidatePool::~IceCandidatePool() {
+  RTC_DCHECK(network_thread_->IsCurrent());
+  network_thread_->Clear(this);
+  allocator_ = nullptr;
+}
+
+std::unique_ptr<cricket::PortAllocator> IceCandidatePool::CreatePortAllocator(
+    rtc::NetworkManager* network_manager,
+    rtc::PacketSocketFactory* socket_factory) {
+  return std::unique_ptr<cricket::PortAllocator>(new PooledPortAllocator(this, network_manager, socket_factory));
+}
+
+IceCandidatePool::Stats IceCandidatePool::GetStats() const {
+  return {pooled_.load(), hits_.load(), misses_.load(), expired_.load()};
+}
+
+void IceCandidatePool::OnMessage(rtc::Message*) {
+  Expire();
+  Refill();
+  network_thread_->PostDelayed(RTC_FROM_HERE, std::max(ttl_ms_ / kExpireChecksPerTtl, kMinExpireCheckIntervalMs), this);
+}
+
+std::unique_ptr<cricket::PortAllocatorSession> IceCandidatePool::Take(
+    cricket::PortAllocator& requester,
+    const std::string& content_name,
+    int component,
+    const std::string& ice_ufrag,
+    const std::string& ice_pwd) {
+  RTC_DCHECK(network_thread_->IsCurrent());
+  if (!Matches(requester)) {
+    misses_++;
+    Configure(requester);
+    return nullptr;
+  }
+
+  Expire();
+  auto session = allocator_->TakePooledSession(content_name, component, ice_ufrag, ice_pwd);
+  if (!session) {
+    misses_++;
+    Refill();
+    return nullptr;
+  }
+  hits_++;
+  created_.pop_front();
+  static_cast<PooledSession*>(session.get())->Claim(allocator_);
+  session->SetCandidateFilter(requester.candidate_filter());
+  Refill();
+  return session;
+}
+
+bool IceCandidatePool::Matches(cricket::PortAllocator& requester) const {
+  return configured_
+      && requester.flags() == allocator_->flags()
+      && requester.step_delay() == allocator_->step_delay()
+      && requester.max_ipv6_networks() == allocator_->max_ipv6_networks()
+      && requester.min_port() == allocator_->min_port()
+      && requester.max_port() == allocator_->max_port()
+      && requester.stun_servers() == allocator_->stun_servers()
+      && requester.turn_servers() == allocator_->turn_servers()
+      && requester.prune_turn_ports() == allocator_->prune_turn_ports()
+      && requester.stun_candidate_keepalive_interval() == allocator_->stun_candidate_keepalive_interval()
+      // A TURN customizer belongs to its RTCPeerConnection.
+      && !requester.turn_customizer();
+}
+
+void IceCandidatePool::Configure(cricket::PortAllocator& requester) {
+  if (requester.turn_customizer()) {
+    return;
+  }
+
+  // Discard the sessions gathered with the old configuration. Claimed sessions
+  // keep the old allocator alive.
+  allocator_ = CreateAllocator();
+  created_.clear();
+  pooled_ = 0;
+
+  allocator_->set_flags(requester.flags());
+  allocator_->set_step_delay(requester.step_delay());
+  allocator_->set_max_ipv6_networks(requester.max_ipv6_networks());
+  allocator_->SetPortRange(requester.min_port(), requester.max_port());
+  allocator_->SetConfiguration(requester.stun_servers(), requester.turn_servers(), 0,
+      requester.prune_turn_ports(), nullptr, requester.stun_candidate_keepalive_interval());
+
+  if (!configured_) {
+    configured_ = true;
+    network_thread_->PostDelayed(RTC_FROM_HERE, std::max(ttl_ms_ / kExpireChecksPerTtl, kMinExpireCheckIntervalMs), this);
+  }
+  Refill();
+}
+
+std::shared_ptr<IceCandidatePool::PoolAllocator> IceCandidatePool::CreateAllocator() {
+  auto allocator = std::make_shared<PoolAllocator>(network_manager_, socket_factory_);
+  allocator->Initialize();
+  return allocator;
+}
+
+void IceCandidatePool::Refill() {
+  if (!configured_) {
+    return;
+  }
+  // SetConfiguration starts new sessions until there are |size_|.
+  allocator_->SetConfiguration(allocator_->stun_servers(), allocator_->turn_servers(), size_,
+      allocator_->prune_turn_ports(), nullptr, allocator_->stun_candidate_keepalive_interval());
+  auto now = rtc::TimeMillis();
+  while (created_.size() < static_cast<size_t>(size_)) {
+    created_.push_back(now);
+  }
+  pooled_ = static_cast<uint32_t>(created_.size());
+}
+
+void IceCandidatePool::Expire() {
+  auto now = rtc::TimeMillis();
+  while (!created_.empty() && now - created_.front() >= ttl_ms_) {
+    // Sessions are taken oldest first.
+    allocator_->TakePooledSession("", 0, kExpiredUfrag, kExpiredPwd);
+    created_.pop_front();
+    expired_++;
+  }
+  pooled_ = static_cast<uint32_t>(created_.size());
+}
+
+}  // namespace node_webrtc
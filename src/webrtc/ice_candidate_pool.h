@@ -0,0 +1,117 @@
+/* Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+
+#include <webrtc/rtc_base/message_handler.h>
+
+namespace cricket {
+
+class PortAllocator;
+class PortAllocatorSession;
+
+}  // namespace cricket
+
+namespace rtc {
+
+class NetworkManager;
+class PacketSocketFactory;
+class Thread;
+
+}  // namespace rtc
+
+namespace node_webrtc {
+
+// IceCandidatePool keeps |size| port allocator sessions gathering candidates
+// ahead of time, on behalf of every RTCPeerConnection using a
+// PeerConnectionFactory. When an RTCPeerConnection starts gathering, it claims
+// one of them, if the pool's configuration (ICE servers, port allocator flags,
+// port range, and so on) matches its own; otherwise, it gathers as usual, and the pool
+// adopts its configuration, so that the next RTCPeerConnection like it hits.
+//
+// Sessions are discarded once they are |ttl_ms| old, since their server
+// reflexive and relay candidates go stale.
+//
+// Each configuration gets its own port allocator, which claimed sessions keep
+// alive, so that switching configurations does not change the ICE servers or
+// network settings of sessions already in use.
+//
+// IceCandidatePool must be created, used, and destroyed on |network_thread|,
+// and outlive every port allocator it creates.
+class IceCandidatePool : public rtc::MessageHandler {
+ public:
+  struct Stats {
+    uint32_t size;
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t expired;
+  };
+
+  IceCandidatePool(
+      rtc::Thread* network_thread,
+      rtc::NetworkManager* network_manager,
+      rtc::PacketSocketFactory* socket_factory,
+      int size,
+      int ttl_ms);
+
+  ~IceCandidatePool() override;
+
+  // Create a port allocator for an RTCPeerConnection which claims sessions
+  // from this pool. May be called from any thread.
+  std::unique_ptr<cricket::PortAllocator> CreatePortAllocator(
+      rtc::NetworkManager* network_manager,
+      rtc::PacketSocketFactory* socket_factory);
+
+  // Safe to call from any thread.
+  Stats GetStats() const;
+
+  // rtc::MessageHandler
+  void OnMessage(rtc::Message*) override;
+
+ private:
+  class PoolAllocator;
+  struct PoolAllocatorOwner;
+  class PooledPortAllocator;
+  class PooledSession;
+
+  std::unique_ptr<cricket::PortAllocatorSession> Take(
+      cricket::PortAllocator& requester,
+      const std::string& content_name,
+      int component,
+      const std::string& ice_ufrag,
+      const std::string& ice_pwd);
+
+  bool Matches(cricket::PortAllocator& requester) const;
+  void Configure(cricket::PortAllocator& requester);
+  std::shared_ptr<PoolAllocator> CreateAllocator();
+  void Refill();
+  void Expire();
+
+  rtc::Thread* network_thread_;
+  rtc::NetworkManager* network_manager_;
+  rtc::PacketSocketFactory* socket_factory_;
+  std::shared_ptr<PoolAllocator> allocator_;
+  int size_;
+  int ttl_ms_;
+  bool configured_ = false;
+
+  // When each pooled session was created, oldest first, like the sessions.
+  std::deque<int64_t> created_;
+
+  std::atomic<uint32_t> pooled_{0};
+  std::atomic<uint64_t> hits_{0};
+  std::atomic<uint64_t> misses_{0};
+  std::atomic<uint64_t> expired_{0};
+};
+
+}  // namespace node_webrtc
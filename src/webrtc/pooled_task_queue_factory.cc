@@ -0,0 +1,258 @@
+/* Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#include "src/webrtc/pooled_task_queue_factory.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include <absl/strings/string_view.h>
+#include <webrtc/api/task_queue/queued_task.h>
+#include <webrtc/api/task_queue/task_queue_base.h>
+#include <webrtc/rtc_base/checks.h>
+#include <webrtc/rtc_base/platform_thread.h>
+#include <webrtc/rtc_base/time_utils.h>
+
+namespace node_webrtc {
+
+namespace {
+
+class PooledTaskQueue;
+
+// A PoolThread runs the tasks of every PooledTaskQueue bound to it, in the
+// order they become ready.
+class PoolThread {
+ public:
+  PoolThread(const std::string& name, rtc::ThreadPriority priority)
+    : thread_(PoolThread::Run, this, name, priority) {
+    thread_.Start();
+  }
+
+  ~PoolThread() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      RTC_DCHECK_EQ(num_queues_, 0);
+      stop_ = true;
+    }
+    wakeup_.notify_all();
+    thread_.Stop();
+  }
+
+  size_t num_queues() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return num_queues_;
+  }
+
+  void AddQueue() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    num_queues_++;
+  }
+
+  void PostTask(PooledTaskQueue* queue, std::unique_ptr<webrtc::QueuedTask> task) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      ready_.push_back({queue, std::move(task)});
+    }
+    wakeup_.notify_all();
+  }
+
+  void PostDelayedTask(PooledTaskQueue* queue, std::unique_ptr<webrtc::QueuedTask> task, uint32_t milliseconds) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      delayed_.emplace(rtc::TimeMillis() + milliseconds, Task{queue, std::move(task)});
+    }
+    wakeup_.notify_all();
+  }
+
+  // Removes every pending task of |queue| and deletes it once none of its tasks
+  // are running. If called from one of |queue|'s own tasks, deletion is
+  // deferred until that task returns.
+  void DeleteQueue(PooledTaskQueue* queue);
+
+ private:
+  struct Task {
+    PooledTaskQueue* queue;
+    std::unique_ptr<webrtc::QueuedTask> task;
+  };
+
+  static void Run(void* obj) {
+    static_cast<PoolThread*>(obj)->Process();
+  }
+
+  void Process();
+
+  rtc::PlatformThread thread_;
+
+  std::mutex mutex_;
+  std::condition_variable wakeup_;
+  std::deque<Task> ready_;
+  std::multimap<int64_t, Task> delayed_;
+  PooledTaskQueue* running_ = nullptr;
+  bool delete_running_ = false;
+  size_t num_queues_ = 0;
+  bool stop_ = false;
+};
+
+class PooledTaskQueue : public webrtc::TaskQueueBase {
+ public:
+  explicit PooledTaskQueue(PoolThread* thread): thread_(thread) {
+    thread_->AddQueue();
+  }
+
+  void Delete() override {
+    thread_->DeleteQueue(this);
+  }
+
+  void PostTask(std::unique_ptr<webrtc::QueuedTask> task) override {
+    thread_->PostTask(this, std::move(task));
+  }
+
+  void PostDelayedTask(std::unique_ptr<webrtc::QueuedTask> task, uint32_t milliseconds) override {
+    thread_->PostDelayedTask(this, std::move(task), milliseconds);
+  }
+
+  void RunTask(std::unique_ptr<webrtc::QueuedTask> task) {
+    CurrentTaskQueueSetter setter(this);
+    if (!task->Run()) {
+      // The task has taken ownership of itself.
+      task.release();
+    }
+  }
+
+ private:
+  ~PooledTaskQueue() override = default;
+
+  friend class PoolThread;
+
+  PoolThread* thread_;
+};
+
+void PoolThread::DeleteQueue(PooledTaskQueue* queue) {
+  // Tasks are destroyed outside of the lock, since their destructors may post
+  // new tasks.
+  std::vector<std::unique_ptr<webrtc::QueuedTask>> removed;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (auto it = ready_.begin(); it != ready_.end();) {
+      if (it->queue == queue) {
+        removed.push_back(std::move(it->task));
+        it = ready_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    for (auto it = delayed_.begin(); it != delayed_.end();) {
+      if (it->second.queue == queue) {
+        removed.push_back(std::move(it->second.task));
+        it = delayed_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    num_queues_--;
+    if (running_ == queue) {
+      if (webrtc::TaskQueueBase::Current() == queue) {
+        delete_running_ = true;
+        queue = nullptr;
+      } else {
+        wakeup_.wait(lock, [this, queue]() { return running_ != queue; });
+      }
+    }
+  }
+  removed.clear();
+  delete queue;
+}
+
+void PoolThread::Process() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (!stop_) {
+    auto now = rtc::TimeMillis();
+    while (!delayed_.empty() && delayed_.begin()->first <= now) {
+      ready_.push_back(std::move(delayed_.begin()->second));
+      delayed_.erase(delayed_.begin());
+    }
+
+    if (ready_.empty()) {
+      if (delayed_.empty()) {
+        wakeup_.wait(lock);
+      } else {
+        wakeup_.wait_for(lock, std::chrono::milliseconds(delayed_.begin()->first - now));
+      }
+      continue;
+    }
+
+    auto task = std::move(ready_.front());
+    ready_.pop_front();
+    running_ = task.queue;
+    lock.unlock();
+
+    task.queue->RunTask(std::move(task.task));
+
+    lock.lock();
+    running_ = nullptr;
+    if (delete_running_) {
+      delete_running_ = false;
+      delete task.queue;
+    }
+    wakeup_.notify_all();
+  }
+}
+
+class PooledTaskQueueFactory : public webrtc::TaskQueueFactory {
+ public:
+  PooledTaskQueueFactory(size_t num_threads, const std::string& thread_name_prefix) {
+    RTC_DCHECK_GT(num_threads, 0);
+    for (size_t i = 0; i < num_threads; i++) {
+      threads_.emplace_back(new PoolThread(thread_name_prefix + std::to_string(i), rtc::kNormalPriority));
+      high_priority_threads_.emplace_back(
+          new PoolThread(thread_name_prefix + "High" + std::to_string(i), rtc::kHighPriority));
+    }
+  }
+
+  std::unique_ptr<webrtc::TaskQueueBase, webrtc::TaskQueueDeleter> CreateTaskQueue(
+      absl::string_view,
+      Priority priority) const override {
+    // High priority task queues (each received video stream's decoding and
+    // rendering queues) must not wait behind another task queue's long task,
+    // such as a video encode, so they get a pool of their own.
+    auto thread = LeastLoaded(priority == Priority::HIGH ? high_priority_threads_ : threads_);
+    return std::unique_ptr<webrtc::TaskQueueBase, webrtc::TaskQueueDeleter>(new PooledTaskQueue(thread));
+  }
+
+ private:
+  static PoolThread* LeastLoaded(const std::vector<std::unique_ptr<PoolThread>>& threads) {
+    auto thread = threads.front().get();
+    auto num_queues = thread->num_queues();
+    for (auto& candidate : threads) {
+      auto candidate_num_queues = candidate->num_queues();
+      if (candidate_num_queues < num_queues) {
+        thread = candidate.get();
+        num_queues = candidate_num_queues;
+      }
+    }
+    return thread;
+  }
+
+  std::vector<std::unique_ptr<PoolThread>> threads_;
+  std::vector<std::unique_ptr<PoolThread>> high_priority_threads_;
+};
+
+}  // namespace
+
+std::unique_ptr<webrtc::TaskQueueFactory> CreatePooledTaskQueueFactory(
+    size_t num_threads,
+    const std::string& thread_name_prefix) {
+  return std::unique_ptr<webrtc::TaskQueueFactory>(new PooledTaskQueueFactory(num_threads, thread_name_prefix));
+}
+
+}  // namespace node_webrtc
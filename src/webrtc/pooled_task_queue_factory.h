@@ -0,0 +1,30 @@
+/* Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include <webrtc/api/task_queue/task_queue_factory.h>
+
+namespace node_webrtc {
+
+// Creates a webrtc::TaskQueueFactory whose task queues share a fixed pool of
+// |num_threads| threads, rather than each getting a thread of its own. Task
+// queues remain serial: each one is bound to the pool thread with the fewest
+// task queues when it is created. High priority task queues share a second
+// pool of |num_threads| high priority threads, so that they never wait behind
+// a normal priority task queue's work.
+//
+// Every task queue must be deleted before the factory is destroyed.
+std::unique_ptr<webrtc::TaskQueueFactory> CreatePooledTaskQueueFactory(
+    size_t num_threads,
+    const std::string& thread_name_prefix);
+
+}  // namespace node_webrtc
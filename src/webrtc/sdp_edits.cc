@@ -0,0 +1,156 @@
+/* Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#include "src/webrtc/sdp_edits.h"
+
+#include <algorithm>
+#include <string>
+#include <utility>
+
+#include <absl/strings/match.h>
+#include <webrtc/media/base/codec.h>
+#include <webrtc/pc/session_description.h>
+
+#include "src/dictionaries/node_webrtc/rtc_sdp_edit.h"
+
+namespace node_webrtc {
+
+namespace {
+
+bool Matches(const RTCSdpEdit& edit, const cricket::ContentInfo& content) {
+  if (edit.mid.IsJust() && edit.mid.UnsafeFromJust() != content.name) {
+    return false;
+  }
+  if (edit.kind.IsJust()) {
+    auto media = content.media_description();
+    return media && media->type() == edit.kind.UnsafeFromJust();
+  }
+  return true;
+}
+
+bool IsListed(const RTCSdpEdit& edit, const std::string& name) {
+  return std::any_of(edit.codecs.begin(), edit.codecs.end(), [&name](const std::string& listed) {
+    return absl::EqualsIgnoreCase(listed, name);
+  });
+}
+
+template <typename C>
+void EditCodecs(const RTCSdpEdit& edit, cricket::MediaContentDescriptionImpl<C>* media) {
+  auto codecs = media->codecs();
+
+  if (!edit.codecs.empty()) {
+    // A stable partition by preference; codecs sharing a name (say, H264
+    // profiles) keep their relative order.
+    std::vector<C> sorted;
+    sorted.reserve(codecs.size());
+    for (auto const& name : edit.codecs) {
+      for (auto const& codec : codecs) {
+        if (absl::EqualsIgnoreCase(codec.name, name)) {
+          sorted.push_back(codec);
+        }
+      }
+    }
+    for (auto const& codec : codecs) {
+      if (!IsListed(edit, codec.name)) {
+        sorted.push_back(codec);
+      }
+    }
+    codecs = std::move(sorted);
+  }
+
+  if (!edit.fmtp.empty()) {
+    for (auto& codec : codecs) {
+      if (edit.codecs.empty() || IsListed(edit, codec.name)) {
+        for (auto const& parameter : edit.fmtp) {
+          codec.SetParam(parameter.first, parameter.second);
+        }
+      }
+    }
+  }
+
+  media->set_codecs(codecs);
+}
+
+void RemoveFromGroups(const std::vector<std::string>& names, cricket::SessionDescription* description) {
+  auto groups = description->groups();
+  for (auto const& group : groups) {
+    description->RemoveGroupByName(group.semantics());
+  }
+  for (auto& group : groups) {
+    for (auto const& name : names) {
+      group.RemoveContentName(name);
+    }
+    if (group.FirstContentName()) {
+      description->AddGroup(group);
+    }
+  }
+}
+
+void RemoveContents(const std::vector<std::string>& names, cricket::SessionDescription* description) {
+  for (auto const& name : names) {
+    description->RemoveContentByName(name);
+    description->RemoveTransportInfoByName(name);
+  }
+  RemoveFromGroups(names, description);
+}
+
+void RejectContents(const std::vector<std::string>& names, cricket::SessionDescription* description) {
+  for (auto const& name : names) {
+    auto content = description->GetContentByName(name);
+    if (content) {
+      content->rejected = true;
+    }
+  }
+  RemoveFromGroups(names, description);
+}
+
+}  // namespace
+
+void ApplySdpEdits(
+    const std::vector<RTCSdpEdit>& edits,
+    webrtc::SdpType type,
+    cricket::SessionDescription* description) {
+  if (!description) {
+    return;
+  }
+
+  for (auto const& edit : edits) {
+    std::vector<std::string> removed;
+    for (auto& content : description->contents()) {
+      if (!Matches(edit, content)) {
+        continue;
+      }
+      if (edit.remove) {
+        removed.push_back(content.name);
+        continue;
+      }
+      auto media = content.media_description();
+      if (!media) {
+        continue;
+      }
+      if (media->as_audio()) {
+        EditCodecs(edit, media->as_audio());
+      } else if (media->as_video()) {
+        EditCodecs(edit, media->as_video());
+      }
+      if (edit.bandwidth.IsJust()) {
+        media->set_bandwidth(static_cast<int>(edit.bandwidth.UnsafeFromJust()) * 1000);
+        media->set_bandwidth_type("AS");
+      }
+    }
+    if (removed.empty()) {
+      continue;
+    }
+    if (type == webrtc::SdpType::kOffer) {
+      RemoveContents(removed, description);
+    } else {
+      RejectContents(removed, description);
+    }
+  }
+}
+
+}  // namespace node_webrtc
@@ -0,0 +1,34 @@
+/* Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#pragma once
+
+#include <vector>
+
+#include <webrtc/api/jsep.h>
+
+namespace cricket { class SessionDescription; }
+
+namespace node_webrtc {
+
+struct RTCSdpEdit;
+
+// Apply |edits|, in order, to the media sections of |description| they match,
+// so that callers need not print, edit, and re-parse the SDP:
+//
+//   1. codecs named in |codecs| (ignoring case) move to the front, in order,
+//   2. |fmtp| parameters are set on those codecs, or on every codec,
+//   3. |bandwidth| becomes the section's "b=AS", and
+//   4. if |remove| is true, the section is removed from an offer, along with
+//      its transport, or rejected (port 0) in an answer, which must keep every
+//      section of the offer; either way, its mid leaves any group.
+void ApplySdpEdits(
+    const std::vector<RTCSdpEdit>& edits,
+    webrtc::SdpType type,
+    cricket::SessionDescription* description);
+
+}  // namespace node_webrtc
@@ -0,0 +1,489 @@
+/* Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#include "src/webrtc/shared_udp_socket_factory.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <deque>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include <webrtc/rtc_base/async_packet_socket.h>
+#include <webrtc/rtc_base/checks.h>
+#include <webrtc/rtc_base/logging.h>
+#include <webrtc/rtc_base/network/sent_packet.h>
+#include <webrtc/rtc_base/socket_address.h>
+#include <webrtc/rtc_base/third_party/sigslot/sigslot.h>
+#include <webrtc/rtc_base/thread.h>
+
+namespace node_webrtc {
+
+namespace {
+
+constexpr uint32_t kStunMagicCookie = 0x2112A442;
+constexpr size_t kStunHeaderSize = 20;
+constexpr size_t kStunTransactionIdOffset = 8;
+constexpr size_t kStunTransactionIdSize = 12;
+constexpr uint16_t kStunUsernameAttribute = 0x0006;
+
+enum class StunClass { kRequest, kIndication, kSuccessResponse, kErrorResponse };
+
+// Responses are routed by the transaction IDs of the requests we sent; these
+// bound how many we remember.
+constexpr size_t kMaxTransactions = 4096;
+constexpr size_t kMaxSentPackets = 4096;
+
+uint16_t ReadUint16(const uint8_t* data) {
+  return static_cast<uint16_t>(data[0] << 8 | data[1]);
+}
+
+uint32_t ReadUint32(const uint8_t* data) {
+  return static_cast<uint32_t>(ReadUint16(data)) << 16 | ReadUint16(data + 2);
+}
+
+bool IsStunMessage(const uint8_t* data, size_t size) {
+  if (size < kStunHeaderSize || (data[0] & 0xc0) != 0 || ReadUint32(data + 4) != kStunMagicCookie) {
+    return false;
+  }
+  auto length = ReadUint16(data + 2);
+  return length % 4 == 0 && kStunHeaderSize + length <= size;
+}
+
+StunClass GetStunClass(const uint8_t* data) {
+  auto type = ReadUint16(data);
+  return static_cast<StunClass>((type & 0x0100) >> 7 | (type & 0x0010) >> 4);
+}
+
+std::string GetStunTransactionId(const uint8_t* data) {
+  return std::string(reinterpret_cast<const char*>(data + kStunTransactionIdOffset), kStunTransactionIdSize);
+}
+
+// Returns the value of the USERNAME attribute, or an empty string.
+std::string GetStunUsername(const uint8_t* data) {
+  auto end = data + kStunHeaderSize + ReadUint16(data + 2);
+  auto attribute = data + kStunHeaderSize;
+  while (attribute + 4 <= end) {
+    auto type = ReadUint16(attribute);
+    auto length = ReadUint16(attribute + 2);
+    if (attribute + 4 + length > end) {
+      break;
+    }
+    if (type == kStunUsernameAttribute) {
+      return std::string(reinterpret_cast<const char*>(attribute + 4), length);
+    }
+    attribute += 4 + ((length + 3) & ~3);
+  }
+  return "";
+}
+
+}  // namespace
+
+// A Socket is what an RTCPeerConnection sees as its UDP socket.
+class SharedUdpSocketMux::Socket : public rtc::AsyncPacketSocket {
+ public:
+  Socket(Endpoint* endpoint, const SharedUdpSocketFactory* owner)
+    : endpoint_(endpoint)
+    , owner_(owner) {}
+
+  ~Socket() override {
+    Close();
+  }
+
+  const SharedUdpSocketFactory* owner() const {
+    return owner_;
+  }
+
+  rtc::SocketAddress GetLocalAddress() const override;
+
+  rtc::SocketAddress GetRemoteAddress() const override {
+    return rtc::SocketAddress();
+  }
+
+  int Send(const void* data, size_t size, const rtc::PacketOptions& options) override {
+    return SendTo(data, size, GetRemoteAddress(), options);
+  }
+
+  int SendTo(
+      const void* data,
+      size_t size,
+      const rtc::SocketAddress& address,
+      const rtc::PacketOptions& options) override;
+
+  int Close() override;
+
+  State GetState() const override {
+    return endpoint_ ? STATE_BOUND : STATE_CLOSED;
+  }
+
+  // Options apply to the shared socket, and so to every Socket using it.
+  int GetOption(rtc::Socket::Option option, int* value) override;
+
+  int SetOption(rtc::Socket::Option option, int value) override;
+
+  int GetError() const override {
+    return error_;
+  }
+
+  void SetError(int error) override {
+    error_ = error;
+  }
+
+  // Called by the Endpoint.
+  void Detach() {
+    endpoint_ = nullptr;
+  }
+
+  void OnReadPacket(const char* data, size_t size, const rtc::SocketAddress& address, int64_t timestamp) {
+    SignalReadPacket(this, data, size, address, timestamp);
+  }
+
+  void OnSentPacket(const rtc::SentPacket& sent_packet) {
+    SignalSentPacket(this, sent_packet);
+  }
+
+  void OnReadyToSend() {
+    SignalReadyToSend(this);
+  }
+
+ private:
+  Endpoint* endpoint_;
+  const SharedUdpSocketFactory* owner_;
+  int error_ = 0;
+};
+
+// An Endpoint is a UDP socket actually bound to a local address, and the
+// Sockets sharing it.
+class SharedUdpSocketMux::Endpoint : public sigslot::has_slots<> {
+ public:
+  Endpoint(SharedUdpSocketMux* mux, rtc::AsyncPacketSocket* socket)
+    : mux_(mux)
+    , socket_(socket) {
+    socket_->SignalReadPacket.connect(this, &Endpoint::OnReadPacket);
+    socket_->SignalSentPacket.connect(this, &Endpoint::OnSentPacket);
+    socket_->SignalReadyToSend.connect(this, &Endpoint::OnReadyToSend);
+  }
+
+  ~Endpoint() override {
+    for (auto socket : sockets_) {
+      socket->Detach();
+    }
+  }
+
+  rtc::AsyncPacketSocket* socket() const {
+    return socket_.get();
+  }
+
+  void Add(Socket* socket) {
+    sockets_.push_back(socket);
+  }
+
+  void Remove(Socket* socket);
+
+  int SendTo(
+      Socket* socket,
+      const void* data,
+      size_t size,
+      const rtc::SocketAddress& address,
+      const rtc::PacketOptions& options);
+
+ private:
+  Socket* Route(const uint8_t* data, size_t size, const rtc::SocketAddress& address);
+  Socket* FindSocketByUsernameFragment(const std::string& ufrag);
+
+  void OnReadPacket(rtc::AsyncPacketSocket*, const char*, size_t, const rtc::SocketAddress&, const int64_t&);
+  void OnSentPacket(rtc::AsyncPacketSocket*, const rtc::SentPacket&);
+  void OnReadyToSend(rtc::AsyncPacketSocket*);
+
+  SharedUdpSocketMux* mux_;
+  std::unique_ptr<rtc::AsyncPacketSocket> socket_;
+  std::vector<Socket*> sockets_;
+
+  std::map<rtc::SocketAddress, Socket*> remotes_;
+  std::unordered_map<std::string, Socket*> ufrags_;
+  std::unordered_map<std::string, Socket*> transactions_;
+  std::deque<std::string> transaction_order_;
+  std::unordered_map<int64_t, Socket*> sent_packets_;
+  std::deque<int64_t> sent_packet_order_;
+  Socket* sending_ = nullptr;
+};
+
+rtc::SocketAddress SharedUdpSocketMux::Socket::GetLocalAddress() const {
+  return endpoint_ ? endpoint_->socket()->GetLocalAddress() : rtc::SocketAddress();
+}
+
+int SharedUdpSocketMux::Socket::SendTo(
+    const void* data,
+    size_t size,
+    const rtc::SocketAddress& address,
+    const rtc::PacketOptions& options) {
+  if (!endpoint_) {
+    SetError(EBADF);
+    return -1;
+  }
+  auto result = endpoint_->SendTo(this, data, size, address, options);
+  if (result < 0) {
+    SetError(endpoint_->socket()->GetError());
+  }
+  return result;
+}
+
+int SharedUdpSocketMux::Socket::Close() {
+  if (endpoint_) {
+    endpoint_->Remove(this);
+    endpoint_ = nullptr;
+  }
+  return 0;
+}
+
+int SharedUdpSocketMux::Socket::GetOption(rtc::Socket::Option option, int* value) {
+  return endpoint_ ? endpoint_->socket()->GetOption(option, value) : -1;
+}
+
+int SharedUdpSocketMux::Socket::SetOption(rtc::Socket::Option option, int value) {
+  return endpoint_ ? endpoint_->socket()->SetOption(option, value) : -1;
+}
+
+void SharedUdpSocketMux::Endpoint::Remove(Socket* socket) {
+  sockets_.erase(std::remove(sockets_.begin(), sockets_.end(), socket), sockets_.end());
+  for (auto it = remotes_.begin(); it != remotes_.end();) {
+    it = it->second == socket ? remotes_.erase(it) : std::next(it);
+  }
+  for (auto it = ufrags_.begin(); it != ufrags_.end();) {
+    it = it->second == socket ? ufrags_.erase(it) : std::next(it);
+  }
+  for (auto it = transactions_.begin(); it != transactions_.end();) {
+    it = it->second == socket ? transactions_.erase(it) : std::next(it);
+  }
+  for (auto it = sent_packets_.begin(); it != sent_packets_.end();) {
+    it = it->second == socket ? sent_packets_.erase(it) : std::next(it);
+  }
+}
+
+int SharedUdpSocketMux::Endpoint::SendTo(
+    Socket* socket,
+    const void* data,
+    size_t size,
+    const rtc::SocketAddress& address,
+    const rtc::PacketOptions& options) {
+  auto bytes = static_cast<const uint8_t*>(data);
+  if (IsStunMessage(bytes, size) && GetStunClass(bytes) == StunClass::kRequest) {
+    // Remember the request, so that we can route its response.
+    auto transaction_id = GetStunTransactionId(bytes);
+    if (transactions_.emplace(transaction_id, socket).second) {
+      transaction_order_.push_back(transaction_id);
+      if (transaction_order_.size() > kMaxTransactions) {
+        transactions_.erase(transaction_order_.front());
+        transaction_order_.pop_front();
+      }
+    }
+    // Connectivity checks are sent with the USERNAME "remote:local".
+    auto username = GetStunUsername(bytes);
+    auto colon = username.find(':');
+    if (colon != std::string::npos) {
+      ufrags_[username.substr(colon + 1)] = socket;
+    }
+  }
+
+  auto remote = remotes_.find(address);
+  if (remote == remotes_.end()) {
+    remotes_.emplace(address, socket);
+  } else if (remote->second != socket) {
+    remote->second = socket;
+  }
+
+  if (options.packet_id != -1) {
+    // Forget the oldest packets first; their SignalSentPackets are likely lost.
+    sent_packets_[options.packet_id] = socket;
+    sent_packet_order_.push_back(options.packet_id);
+    if (sent_packet_order_.size() > kMaxSentPackets) {
+      auto oldest = sent_packets_.find(sent_packet_order_.front());
+      sent_packet_order_.pop_front();
+      if (oldest != sent_packets_.end() && oldest->first != options.packet_id) {
+        sent_packets_.erase(oldest);
+      }
+    }
+  }
+
+  sending_ = socket;
+  auto result = socket_->SendTo(data, size, address, options);
+  sending_ = nullptr;
+  if (result < 0 && options.packet_id != -1) {
+    sent_packets_.erase(options.packet_id);
+  }
+  return result;
+}
+
+SharedUdpSocketMux::Socket* SharedUdpSocketMux::Endpoint::FindSocketByUsernameFragment(const std::string& ufrag) {
+  auto it = ufrags_.find(ufrag);
+  if (it != ufrags_.end()) {
+    return it->second;
+  }
+  // We have not sent a connectivity check for |ufrag| yet, so ask which
+  // SharedUdpSocketFactory signaled it, and pick that factory's newest Socket.
+  auto owner = mux_->GetOwner(ufrag);
+  if (!owner) {
+    return nullptr;
+  }
+  auto socket = std::find_if(sockets_.rbegin(), sockets_.rend(), [owner](Socket* socket) {
+    return socket->owner() == owner;
+  });
+  if (socket == sockets_.rend()) {
+    return nullptr;
+  }
+  ufrags_[ufrag] = *socket;
+  return *socket;
+}
+
+SharedUdpSocketMux::Socket* SharedUdpSocketMux::Endpoint::Route(
+    const uint8_t* data,
+    size_t size,
+    const rtc::SocketAddress& address) {
+  if (IsStunMessage(data, size)) {
+    switch (GetStunClass(data)) {
+      case StunClass::kSuccessResponse:
+      case StunClass::kErrorResponse: {
+        auto it = transactions_.find(GetStunTransactionId(data));
+        if (it != transactions_.end()) {
+          return it->second;
+        }
+        break;
+      }
+      case StunClass::kRequest: {
+        // Connectivity checks are received with the USERNAME "local:remote".
+        auto username = GetStunUsername(data);
+        auto socket = FindSocketByUsernameFragment(username.substr(0, username.find(':')));
+        if (socket) {
+          // The remote address may be new to us (a peer-reflexive candidate).
+          remotes_[address] = socket;
+          return socket;
+        }
+        break;
+      }
+      case StunClass::kIndication:
+        break;
+    }
+  }
+  auto it = remotes_.find(address);
+  return it != remotes_.end() ? it->second : nullptr;
+}
+
+void SharedUdpSocketMux::Endpoint::OnReadPacket(
+    rtc::AsyncPacketSocket*,
+    const char* data,
+    size_t size,
+    const rtc::SocketAddress& address,
+    const int64_t& timestamp) {
+  auto socket = Route(reinterpret_cast<const uint8_t*>(data), size, address);
+  if (!socket) {
+    RTC_LOG(LS_VERBOSE) << "Dropping a datagram from " << address.ToSensitiveString()
+                        << " with no RTCPeerConnection to route it to";
+    return;
+  }
+  socket->OnReadPacket(data, size, address, timestamp);
+}
+
+void SharedUdpSocketMux::Endpoint::OnSentPacket(rtc::AsyncPacketSocket*, const rtc::SentPacket& sent_packet) {
+  auto socket = sending_;
+  auto it = sent_packets_.find(sent_packet.packet_id);
+  if (it != sent_packets_.end()) {
+    socket = it->second;
+    sent_packets_.erase(it);
+  }
+  if (socket) {
+    socket->OnSentPacket(sent_packet);
+  }
+}
+
+void SharedUdpSocketMux::Endpoint::OnReadyToSend(rtc::AsyncPacketSocket*) {
+  // A Socket may close in response, so iterate over a copy.
+  auto sockets = sockets_;
+  for (auto socket : sockets) {
+    if (std::find(sockets_.begin(), sockets_.end(), socket) != sockets_.end()) {
+      socket->OnReadyToSend();
+    }
+  }
+}
+
+SharedUdpSocketMux::SharedUdpSocketMux(rtc::Thread* thread, rtc::PacketSocketFactory* factory, uint16_t port)
+  : thread_(thread)
+  , factory_(factory)
+  , port_(port) {}
+
+SharedUdpSocketMux::~SharedUdpSocketMux() {
+  RTC_DCHECK(thread_->IsCurrent());
+  endpoints_.clear();
+}
+
+std::unique_ptr<SharedUdpSocketFactory> SharedUdpSocketMux::CreateSocketFactory() {
+  return std::unique_ptr<SharedUdpSocketFactory>(new SharedUdpSocketFactory(thread_, this));
+}
+
+rtc::AsyncPacketSocket* SharedUdpSocketMux::CreateSocket(
+    const SharedUdpSocketFactory* owner,
+    const rtc::SocketAddress& address) {
+  RTC_DCHECK(thread_->IsCurrent());
+  auto it = endpoints_.find(address.ipaddr());
+  if (it == endpoints_.end()) {
+    auto socket = factory_->CreateUdpSocket(rtc::SocketAddress(address.ipaddr(), 0), port_, port_);
+    if (!socket) {
+      RTC_LOG(LS_ERROR) << "Failed to bind a shared UDP socket to " << address.ipaddr().ToSensitiveString()
+                        << ":" << port_;
+      return nullptr;
+    }
+    // An ephemeral port is picked once, and then used for every address.
+    if (!port_) {
+      port_ = socket->GetLocalAddress().port();
+    }
+    it = endpoints_.emplace(address.ipaddr(), std::unique_ptr<Endpoint>(new Endpoint(this, socket))).first;
+  }
+  auto socket = new Socket(it->second.get(), owner);
+  it->second->Add(socket);
+  return socket;
+}
+
+void SharedUdpSocketMux::AddUsernameFragment(const SharedUdpSocketFactory* owner, const std::string& ufrag) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  owners_[ufrag] = owner;
+}
+
+void SharedUdpSocketMux::RemoveOwner(const SharedUdpSocketFactory* owner) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto it = owners_.begin(); it != owners_.end();) {
+    it = it->second == owner ? owners_.erase(it) : std::next(it);
+  }
+}
+
+const SharedUdpSocketFactory* SharedUdpSocketMux::GetOwner(const std::string& ufrag) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = owners_.find(ufrag);
+  return it != owners_.end() ? it->second : nullptr;
+}
+
+SharedUdpSocketFactory::SharedUdpSocketFactory(rtc::Thread* thread, SharedUdpSocketMux* mux)
+  : rtc::BasicPacketSocketFactory(thread)
+  , mux_(mux) {}
+
+SharedUdpSocketFactory::~SharedUdpSocketFactory() {
+  mux_->RemoveOwner(this);
+}
+
+void SharedUdpSocketFactory::AddUsernameFragment(const std::string& ufrag) {
+  mux_->AddUsernameFragment(this, ufrag);
+}
+
+rtc::AsyncPacketSocket* SharedUdpSocketFactory::CreateUdpSocket(
+    const rtc::SocketAddress& address,
+    uint16_t,
+    uint16_t) {
+  // Every RTCPeerConnection shares the mux's port, so the port range does not
+  // apply.
+  return mux_->CreateSocket(this, address);
+}
+
+}  // namespace node_webrtc
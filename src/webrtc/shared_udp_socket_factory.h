@@ -0,0 +1,104 @@
+/* Copyright (c) 2019 The node-webrtc project authors. All rights reserved.
+ *
+ * Use of this source code is governed by a BSD-style license that can be found
+ * in the LICENSE.md file in the root of the source tree. All contributing
+ * project authors may be found in the AUTHORS file in the root of the source
+ * tree.
+ */
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include <webrtc/p2p/base/basic_packet_socket_factory.h>
+#include <webrtc/rtc_base/ip_address.h>
+
+namespace rtc {
+
+class AsyncPacketSocket;
+class PacketSocketFactory;
+class SocketAddress;
+class Thread;
+
+}  // namespace rtc
+
+namespace node_webrtc {
+
+class SharedUdpSocketFactory;
+
+// SharedUdpSocketMux multiplexes the UDP sockets of many RTCPeerConnections
+// over a single UDP socket per local IP address, all bound to the same port.
+// Incoming datagrams are demultiplexed
+//
+//   1. by STUN transaction ID, for responses to STUN requests we sent,
+//   2. by the local ICE username fragment, for STUN requests, and
+//   3. by remote address, for everything else.
+//
+// This means two RTCPeerConnections sharing a port cannot talk to the same
+// remote address. In particular, relayed traffic from a TURN server several
+// of them use would go to whichever sent to it last, so RTCPeerConnection
+// refuses TURN servers over UDP when sharing a port.
+//
+// Sockets must be created and used on |thread|, the network thread.
+class SharedUdpSocketMux {
+ public:
+  // UDP sockets are created with |factory| and bound to |port|. If |port| is
+  // 0, the first socket is bound to an ephemeral port, and the rest to the
+  // same port.
+  SharedUdpSocketMux(rtc::Thread* thread, rtc::PacketSocketFactory* factory, uint16_t port);
+
+  ~SharedUdpSocketMux();
+
+  // Create a SharedUdpSocketFactory for a single RTCPeerConnection.
+  std::unique_ptr<SharedUdpSocketFactory> CreateSocketFactory();
+
+ private:
+  friend class SharedUdpSocketFactory;
+
+  class Endpoint;
+  class Socket;
+
+  rtc::AsyncPacketSocket* CreateSocket(const SharedUdpSocketFactory* owner, const rtc::SocketAddress& address);
+
+  // These may be called from any thread.
+  void AddUsernameFragment(const SharedUdpSocketFactory* owner, const std::string& ufrag);
+  void RemoveOwner(const SharedUdpSocketFactory* owner);
+  const SharedUdpSocketFactory* GetOwner(const std::string& ufrag);
+
+  rtc::Thread* thread_;
+  rtc::PacketSocketFactory* factory_;
+  uint16_t port_;
+  std::map<rtc::IPAddress, std::unique_ptr<Endpoint>> endpoints_;
+
+  std::mutex mutex_;
+  std::unordered_map<std::string, const SharedUdpSocketFactory*> owners_;
+};
+
+// SharedUdpSocketFactory creates an RTCPeerConnection's UDP sockets on a
+// SharedUdpSocketMux. TCP sockets are created by rtc::BasicPacketSocketFactory,
+// as usual.
+class SharedUdpSocketFactory : public rtc::BasicPacketSocketFactory {
+ public:
+  SharedUdpSocketFactory(rtc::Thread* thread, SharedUdpSocketMux* mux);
+
+  ~SharedUdpSocketFactory() override;
+
+  // Route STUN requests for |ufrag| to this factory's sockets. Call this
+  // before signaling a local ICE candidate, so that the remote peer's
+  // connectivity checks find their way here.
+  void AddUsernameFragment(const std::string& ufrag);
+
+  rtc::AsyncPacketSocket* CreateUdpSocket(
+      const rtc::SocketAddress& address,
+      uint16_t min_port,
+      uint16_t max_port) override;
+
+ private:
+  SharedUdpSocketMux* mux_;
+};
+
+}  // namespace node_webrtc
@@ -10,9 +10,11 @@
 #include "src/webrtc/test_audio_device_module.h"
 
 #include <algorithm>
+#include <cmath>
 #include <cstdlib>
 #include <iosfwd>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 #include <absl/memory/memory.h>
@@ -45,7 +47,8 @@ class TestAudioDeviceModuleImpl  // NOLINT
   : public webrtc::webrtc_impl::AudioDeviceModuleDefault<TestAudioDeviceModule> {
  public:
   // Creates a new TestAudioDeviceModule. When capturing or playing, 10 ms audio
-  // frames will be processed every 10ms / |speed|.
+  // frames will be processed every 10ms / |speed|. An infinite |speed|
+  // processes frames as fast as possible.
   // |capturer| is an object that produces audio data. Can be nullptr if this
   // device is never used for recording.
   // |renderer| is an object that receives audio data that would have been
@@ -56,7 +59,8 @@ class TestAudioDeviceModuleImpl  // NOLINT
       float speed = 1)
     : capturer_(std::move(capturer)),
       renderer_(std::move(renderer)),
-      process_interval_us_(kFrameLengthUs / speed),
+      free_running_(std::isinf(speed)),
+      process_interval_us_(free_running_ ? 0 : static_cast<double>(kFrameLengthUs) / speed),
       audio_callback_(nullptr),
       rendering_(false),
       capturing_(false),
@@ -82,20 +86,13 @@ class TestAudioDeviceModuleImpl  // NOLINT
   ~TestAudioDeviceModuleImpl() override {
     StopPlayout();  // NOLINT
     StopRecording();  // NOLINT
-    if (thread_) {
-      {
-        rtc::CritScope cs(&lock_);
-        stop_thread_ = true;
-      }
-      thread_->Stop();
-    }
   }
 
+  // NOTE: The processing thread is started lazily, by StartPlayout, and
+  // stopped once neither playout nor recording is active, so that a
+  // TestAudioDeviceModule which is not playing out does not wake up every
+  // 10 ms.
   int32_t Init() override {
-    thread_ = absl::make_unique<rtc::PlatformThread>(
-            TestAudioDeviceModuleImpl::Run, this, "TestAudioDeviceModuleImpl",
-            rtc::kHighPriority);
-    thread_->Start();
     return 0;
   }
 
@@ -107,32 +104,49 @@ class TestAudioDeviceModuleImpl  // NOLINT
   }
 
   int32_t StartPlayout() override {
+    rtc::CritScope thread_cs(&thread_lock_);
     rtc::CritScope cs(&lock_);
-    RTC_CHECK(renderer_);
+    if (!renderer_) {
+      return -1;
+    }
     rendering_ = true;
     done_rendering_.Reset();
+    StartThreadIfNeeded();
+    playout_started_.Set();
     return 0;
   }
 
   int32_t StopPlayout() override {
-    rtc::CritScope cs(&lock_);
-    rendering_ = false;
-    done_rendering_.Set();
+    rtc::CritScope thread_cs(&thread_lock_);
+    {
+      rtc::CritScope cs(&lock_);
+      rendering_ = false;
+      done_rendering_.Set();
+    }
+    StopThreadIfIdle();
     return 0;
   }
 
+  // Capture is disabled (see ProcessAudio), so recording does not start the
+  // processing thread.
   int32_t StartRecording() override {
     rtc::CritScope cs(&lock_);
-    RTC_CHECK(capturer_);
+    if (!capturer_) {
+      return -1;
+    }
     capturing_ = true;
     done_capturing_.Reset();
     return 0;
   }
 
   int32_t StopRecording() override {
-    rtc::CritScope cs(&lock_);
-    capturing_ = false;
-    done_capturing_.Set();
+    rtc::CritScope thread_cs(&thread_lock_);
+    {
+      rtc::CritScope cs(&lock_);
+      capturing_ = false;
+      done_capturing_.Set();
+    }
+    StopThreadIfIdle();
     return 0;
   }
 
@@ -159,15 +173,47 @@ class TestAudioDeviceModuleImpl  // NOLINT
   }
 
  private:
+  void StartThreadIfNeeded() RTC_EXCLUSIVE_LOCKS_REQUIRED(thread_lock_, lock_) {
+    if (thread_) {
+      return;
+    }
+    stop_thread_ = false;
+    thread_ = absl::make_unique<rtc::PlatformThread>(
+            TestAudioDeviceModuleImpl::Run, this, "TestAudioDeviceModuleImpl",
+            rtc::kHighPriority);
+    thread_->Start();
+  }
+
+  // Stops and joins the processing thread, unless playout or recording is
+  // still active. |lock_| must not be held, since the thread takes it.
+  void StopThreadIfIdle() RTC_EXCLUSIVE_LOCKS_REQUIRED(thread_lock_) {
+    std::unique_ptr<rtc::PlatformThread> thread;
+    {
+      rtc::CritScope cs(&lock_);
+      if (rendering_ || capturing_) {
+        return;
+      }
+      stop_thread_ = true;
+      thread = std::move(thread_);
+    }
+    playout_started_.Set();
+    if (thread) {
+      thread->Stop();
+    }
+  }
+
   void ProcessAudio() {
-    int64_t time_us = rtc::TimeMicros();
+    // Accumulated in double, so that intervals shorter than 1 us still pace.
+    double time_us = rtc::TimeMicros();
     bool logged_once = false;
     for (;;) {
+      bool playing;
       {
         rtc::CritScope cs(&lock_);
         if (stop_thread_) {
           return;
         }
+        playing = rendering_;
         // NOTE(mroberts): I've disabled this, as it was causing the following
         // error (and it's not really used by node-webrtc).
         //
@@ -212,9 +258,23 @@ class TestAudioDeviceModuleImpl  // NOLINT
           }
         }
       }
+      // Only playout does any work, so wait for it to (re)start rather than
+      // spinning or ticking while it is stopped.
+      if (!playing) {
+        playout_started_.Wait(rtc::Event::kForever);
+        time_us = rtc::TimeMicros();
+        continue;
+      }
+
+      // An infinite speed means we are free-running: process the next frame
+      // immediately, without pacing or "too slow" warnings.
+      if (free_running_) {
+        continue;
+      }
+
       time_us += process_interval_us_;
 
-      int64_t time_left_us = time_us - rtc::TimeMicros();
+      auto time_left_us = static_cast<int64_t>(time_us) - rtc::TimeMicros();
       if (time_left_us < 0) {
         if (!logged_once) {
           RTC_LOG(LS_ERROR) << "ProcessAudio is too slow";
@@ -225,7 +285,7 @@ class TestAudioDeviceModuleImpl  // NOLINT
           if (rtc::Thread::SleepMs(time_left_us / 1000)) {  // NOLINT
             break;
           }
-          time_left_us = time_us - rtc::TimeMicros();
+          time_left_us = static_cast<int64_t>(time_us) - rtc::TimeMicros();
         }
       }
     }
@@ -237,19 +297,24 @@ class TestAudioDeviceModuleImpl  // NOLINT
 
   const std::unique_ptr<Capturer> capturer_ RTC_GUARDED_BY(lock_);
   const std::unique_ptr<Renderer> renderer_ RTC_GUARDED_BY(lock_);
-  const int64_t process_interval_us_;
+  const bool free_running_;
+  const double process_interval_us_;
 
+  // Serializes starting and stopping |thread_|, and is held while joining it.
+  rtc::CriticalSection thread_lock_;
   rtc::CriticalSection lock_;
   webrtc::AudioTransport* audio_callback_ RTC_GUARDED_BY(lock_);
   bool rendering_ RTC_GUARDED_BY(lock_);
   bool capturing_ RTC_GUARDED_BY(lock_);
   rtc::Event done_rendering_;
   rtc::Event done_capturing_;
+  // Set when playout starts, or the thread should stop.
+  rtc::Event playout_started_;
 
   std::vector<int16_t> playout_buffer_ RTC_GUARDED_BY(lock_);
   rtc::BufferT<int16_t> recording_buffer_ RTC_GUARDED_BY(lock_);
 
-  std::unique_ptr<rtc::PlatformThread> thread_;
+  std::unique_ptr<rtc::PlatformThread> thread_ RTC_GUARDED_BY(thread_lock_);
   bool stop_thread_ RTC_GUARDED_BY(lock_);
 };
 
@@ -73,12 +73,15 @@ class TestAudioDeviceModule : public webrtc::AudioDeviceModule {
   ~TestAudioDeviceModule() override = default;
 
   // Creates a new TestAudioDeviceModule. When capturing or playing, 10 ms audio
-  // frames will be processed every 10ms / |speed|.
+  // frames will be processed every 10ms / |speed|. An infinite |speed|
+  // processes frames as fast as possible.
   // |capturer| is an object that produces audio data. Can be nullptr if this
   // device is never used for recording.
   // |renderer| is an object that receives audio data that would have been
   // played out. Can be nullptr if this device is never used for playing.
   // Use one of the Create... functions to get these instances.
+  // No thread runs unless playout is active; if |capturer| or |renderer| is
+  // nullptr, starting recording or playout (respectively) fails.
   static rtc::scoped_refptr<TestAudioDeviceModule> CreateTestAudioDeviceModule(
       std::unique_ptr<Capturer> capturer,
       std::unique_ptr<Renderer> renderer,
@@ -2,7 +2,7 @@
 
 const test = require('tape');
 
-const { RTCPeerConnection } = require('..');
+const { RTCIceCandidate, RTCPeerConnection } = require('..');
 
 const offer = {
   type: 'offer',
@@ -46,3 +46,73 @@ test('addIceCandidate', t => {
 
   t.end();
 });
+
+test('addIceCandidates', t => {
+  test('adds every candidate, with the same queueing behavior', async t => {
+    const pc = new RTCPeerConnection();
+    const candidates = [
+      candidate,
+      Object.assign({}, candidate, {
+        candidate: 'candidate:559267640 1 udp 2122267903 ::1 57694 typ host generation 0 ufrag ZVjA network-id 2'
+      })
+    ];
+    await Promise.all([
+      pc.setRemoteDescription(offer),
+      pc.addIceCandidates(candidates)
+    ]);
+    t.ok(candidates.every(({ candidate }) => pc.remoteDescription.sdp.includes(candidate.split(' ').slice(4, 6).join(' '))),
+      'the remote description has every candidate');
+    pc.close();
+    t.end();
+  });
+
+  test('rejects with the indices of the candidates it failed to add', async t => {
+    const pc = new RTCPeerConnection();
+    await pc.setRemoteDescription(offer);
+    await pc.addIceCandidates([candidate, Object.assign({}, candidate, { sdpMid: '1', sdpMLineIndex: 1 })]).then(
+      () => t.fail('addIceCandidates should reject'),
+      error => t.ok(/indices 1\b/.test(error.message), 'names the failed index'));
+    pc.close();
+    await pc.addIceCandidates([candidate]).then(
+      () => t.fail('addIceCandidates should reject'),
+      () => t.pass('rejects once closed'));
+    t.end();
+  });
+
+  t.end();
+});
+
+test('batchIceCandidates', t => {
+  test('delivers local candidates in batches, the last one complete', async t => {
+    const pc = new RTCPeerConnection();
+    pc.batchIceCandidates(50);
+    let icecandidate = 0;
+    pc.addEventListener('icecandidate', ({ candidate }) => {
+      if (candidate) {
+        icecandidate++;
+      }
+    });
+    const batches = [];
+    const complete = new Promise(resolve => {
+      pc.onicecandidates = event => {
+        batches.push(event.candidates);
+        if (event.complete) {
+          resolve();
+        }
+      };
+    });
+    pc.createDataChannel('foo');
+    await pc.setLocalDescription(await pc.createOffer());
+    await complete;
+    t.equal(icecandidate, 0, 'no icecandidate events were dispatched for candidates');
+    t.ok(batches.every(candidates => candidates.every(candidate => candidate instanceof RTCIceCandidate)),
+      'every batch is an Array of RTCIceCandidates');
+    t.equal([].concat(...batches).filter(({ candidate }) => !pc.localDescription.sdp.includes(candidate)).length, 0,
+      'the local description has every candidate');
+    pc.close();
+    t.throws(() => pc.batchIceCandidates(), /closed/, 'throws once closed');
+    t.end();
+  });
+
+  t.end();
+});
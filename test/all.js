@@ -15,16 +15,20 @@ require('./mediastream');
 require('./multiconnect');
 require('./pass-interface-to-method');
 require('./rollback');
+require('./rtcaudiomixer');
 require('./rtcaudiosink');
 require('./rtcaudiosource');
 require('./rtcdtlstransport');
 require('./rtcdatachannel');
+require('./rtcpeerconnectionfactory');
 require('./rtcrtpreceiver');
 require('./rtcrtpsender');
 require('./rtcvideosink');
 require('./rtcvideosource');
+require('./sdp-edits');
 require('./send-arraybuffer');
 require('./sessiondesc');
+require('./stats');
 
 // TODO(mroberts): async_hooks were introduced in Node 9. We use them to test
 // that destructors fire at the appropriate time (and hence, no memory leaks
@@ -0,0 +1,79 @@
+'use strict';
+
+const test = require('tape');
+
+const { RTCAudioMixer, RTCAudioSink, RTCAudioSource } = require('..').nonstandard;
+
+function createData(amplitude) {
+  const sampleRate = 8000;
+  const samples = new Int16Array(sampleRate / 100);  // 10 ms
+  samples.fill(amplitude);
+  return { samples, sampleRate };
+}
+
+test('RTCAudioMixer mixes inputs into a single track', t => {
+  const mixer = new RTCAudioMixer({ sampleRate: 16000 });
+  t.ok(!mixer.stopped, 'RTCAudioMixer initially is not stopped');
+  t.equal(mixer.activeSpeaker, null, 'activeSpeaker is initially null');
+
+  const sources = [new RTCAudioSource(), new RTCAudioSource()];
+  const tracks = sources.map(source => source.createTrack());
+  tracks.forEach(track => mixer.addInput(track));
+  mixer.setGain(tracks[1], 0.5);
+
+  const mixedTrack = mixer.createTrack();
+  const sink = new RTCAudioSink(mixedTrack);
+
+  const interval = setInterval(() => {
+    sources[0].onData(createData(1000));
+    sources[1].onData(createData(0));
+  }, 10);
+
+  const receivedData = new Promise(resolve => { sink.ondata = resolve; });
+  const activeSpeakerChanged = new Promise(resolve => { mixer.onactivespeakerchange = resolve; });
+
+  Promise.all([receivedData, activeSpeakerChanged]).then(([data, event]) => {
+    t.equal(data.sampleRate, 16000, 'mixed audio has the requested sampleRate');
+    t.equal(data.channelCount, 1, 'mixed audio has the requested channelCount');
+    t.equal(data.numberOfFrames, 160, 'mixed audio is delivered in 10 ms frames');
+    t.equal(event.track, tracks[0], 'the loudest input becomes the active speaker');
+    t.equal(mixer.activeSpeaker, tracks[0], 'activeSpeaker is updated');
+
+    clearInterval(interval);
+    mixer.removeInput(tracks[1]);
+    t.throws(() => mixer.setGain(tracks[1], 1), 'setGain throws for a removed input');
+
+    mixer.stop();
+    t.ok(mixer.stopped, 'RTCAudioMixer is finally stopped');
+    t.equal(mixer.activeSpeaker, null, 'activeSpeaker is reset when stopped');
+
+    sink.stop();
+    mixedTrack.stop();
+    tracks.forEach(track => track.stop());
+    t.end();
+  });
+});
+
+test('RTCAudioMixer does not replace a local track\'s other sinks', t => {
+  const mixer = new RTCAudioMixer();
+  const source = new RTCAudioSource();
+  const track = source.createTrack();
+  const sink = new RTCAudioSink(track);
+
+  let dataEvents = 0;
+  sink.ondata = () => dataEvents++;
+
+  mixer.addInput(track);
+  source.onData(createData(1000));
+  mixer.removeInput(track);
+  source.onData(createData(1000));
+
+  // "data" events are dispatched asynchronously.
+  setTimeout(() => {
+    t.equal(dataEvents, 2, 'the RTCAudioSink receives data while mixed and after being removed');
+    mixer.stop();
+    sink.stop();
+    track.stop();
+    t.end();
+  }, 100);
+});
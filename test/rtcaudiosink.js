@@ -3,7 +3,7 @@
 const test = require('tape');
 
 const { getUserMedia } = require('..');
-const { RTCAudioSink } = require('..').nonstandard;
+const { RTCAudioSink, RTCAudioSource } = require('..').nonstandard;
 
 test('RTCAudioSink', t => {
   return getUserMedia({ audio: true }).then(stream => {
@@ -16,3 +16,67 @@ test('RTCAudioSink', t => {
     t.end();
   });
 });
+
+test('RTCAudioSink with voice activity detection', t => {
+  const source = new RTCAudioSource();
+  const track = source.createTrack();
+  const sink = new RTCAudioSink(track, {
+    vad: true,
+    suppressSilence: true,
+    levelInterval: 10
+  });
+  t.ok(!sink.speaking, 'RTCAudioSink initially is not speaking');
+
+  let dataEvents = 0;
+  sink.ondata = () => dataEvents++;
+
+  sink.onlevel = event => {
+    sink.onlevel = null;
+    t.equal(event.level, -127, 'silence is reported as -127 dBov');
+    t.equal(dataEvents, 0, 'no "data" events are raised during silence');
+    sink.stop();
+    track.stop();
+    t.end();
+  };
+
+  const sampleRate = 48000;
+  source.onData({
+    samples: new Int16Array(sampleRate / 100),
+    sampleRate
+  });
+});
+
+test('RTCAudioSink with voice activity detection treats unsupported sample rates as voice', t => {
+  const source = new RTCAudioSource();
+  const track = source.createTrack();
+  const sink = new RTCAudioSink(track, { vad: true, suppressSilence: true });
+
+  sink.onspeakingchange = event => {
+    t.ok(event.speaking, 'silence at 44.1 kHz is considered voice');
+  };
+
+  sink.ondata = event => {
+    sink.ondata = null;
+    t.equal(event.sampleRate, 44100, '"data" events are not suppressed');
+    sink.stop();
+    track.stop();
+    t.end();
+  };
+
+  const sampleRate = 44100;
+  source.onData({
+    samples: new Int16Array(sampleRate / 100),
+    sampleRate
+  });
+});
+
+test('RTCAudioSink with invalid options', t => {
+  const source = new RTCAudioSource();
+  const track = source.createTrack();
+  t.throws(() => new RTCAudioSink(track, { suppressSilence: true }),
+    'suppressSilence requires vad');
+  t.throws(() => new RTCAudioSink(track, { vad: true, vadAggressiveness: 4 }),
+    'vadAggressiveness must be between 0 and 3');
+  track.stop();
+  t.end();
+});
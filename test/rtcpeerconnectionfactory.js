@@ -0,0 +1,364 @@
+'use strict';
+
+const test = require('tape');
+
+const { RTCPeerConnection } = require('..');
+const { RTCPeerConnectionFactory, RTCPeerConnectionFactoryPool } = require('..').nonstandard;
+
+const { createRTCPeerConnections, gatherCandidates, negotiate, waitForStateChange } = require('./lib/pc');
+
+// Create an RTCDataChannel from pc1 to pc2 which sends "hello" once open.
+// Resolves with the first message pc2 receives on it.
+function sendHello(pc1, pc2) {
+  const channel = pc1.createDataChannel('test');
+  channel.onopen = () => channel.send('hello');
+  return new Promise(resolve => {
+    pc2.ondatachannel = ({ channel }) => { channel.onmessage = ({ data }) => resolve(data); };
+  });
+}
+
+test('RTCPeerConnectionFactory.setDefaultOptions validates its options', t => {
+  t.throws(() => RTCPeerConnectionFactory.setDefaultOptions({ audioRenderer: 'speakers' }), /TypeError/,
+    'throws for an unknown audioRenderer');
+  t.throws(() => RTCPeerConnectionFactory.setDefaultOptions({ audioCapturer: 'microphone' }), /TypeError/,
+    'throws for an unknown audioCapturer');
+  t.throws(() => RTCPeerConnectionFactory.setDefaultOptions({ audioRenderer: 'wav' }), /TypeError/,
+    'throws when audioRenderer is "wav" but audioRendererFile is missing');
+  t.throws(() => RTCPeerConnectionFactory.setDefaultOptions({ audioSpeed: 0 }), /TypeError/,
+    'throws for an audioSpeed of 0');
+  t.throws(() => RTCPeerConnectionFactory.setDefaultOptions({ networkThreadAffinity: 0 }), /TypeError/,
+    'throws when networkThreadAffinity is not an array');
+  t.throws(() => RTCPeerConnectionFactory.setDefaultOptions({ networkSocketServer: 'kqueue' }), /TypeError/,
+    'throws for an unknown networkSocketServer');
+  t.throws(() => RTCPeerConnectionFactory.setDefaultOptions({ networkRefreshInterval: 0 }), /TypeError/,
+    'throws for a networkRefreshInterval of 0');
+  t.throws(() => RTCPeerConnectionFactory.setDefaultOptions({ networkInterfaceDenylist: 'docker0' }), /TypeError/,
+    'throws when networkInterfaceDenylist is not an array');
+  t.throws(() => RTCPeerConnectionFactory.setDefaultOptions({ iceCandidatePoolTtl: 0 }), /TypeError/,
+    'throws for an iceCandidatePoolTtl of 0');
+  t.throws(() => RTCPeerConnectionFactory.setDefaultOptions({ iceCandidatePoolSize: 1, sharedUdpPort: 0 }), /TypeError/,
+    'throws for an iceCandidatePoolSize with a sharedUdpPort');
+  t.end();
+});
+
+test('RTCPeerConnectionFactory can be constructed without an audio capturer or renderer', t => {
+  const factory = new RTCPeerConnectionFactory({ audioCapturer: 'none', audioRenderer: 'none' });
+  t.ok(factory instanceof RTCPeerConnectionFactory, 'constructs an RTCPeerConnectionFactory');
+  t.end();
+});
+
+test('RTCPeerConnectionFactory throws when audioRendererFile cannot be written', t => {
+  const options = { audioRenderer: 'wav', audioRendererFile: '/nonexistent/directory/audio.wav' };
+  t.throws(() => new RTCPeerConnectionFactory(options), /TypeError/,
+    'the constructor throws');
+  t.throws(() => RTCPeerConnectionFactory.setDefaultOptions(options), /TypeError/,
+    'setDefaultOptions throws');
+  t.end();
+});
+
+test('RTCPeerConnectionFactory can be constructed with a free-running audio device', t => {
+  const factory = new RTCPeerConnectionFactory({ audioSpeed: Infinity });
+  t.ok(factory instanceof RTCPeerConnectionFactory, 'constructs an RTCPeerConnectionFactory');
+  t.end();
+});
+
+test('RTCPeerConnectionFactory can be constructed with thread names and CPU affinity', t => {
+  const factory = new RTCPeerConnectionFactory({
+    threadNamePrefix: 'test',
+    networkThreadAffinity: [0],
+    workerThreadAffinity: [0],
+    signalingThreadAffinity: [0]
+  });
+  t.ok(factory instanceof RTCPeerConnectionFactory, 'constructs an RTCPeerConnectionFactory');
+  t.end();
+});
+
+test('RTCPeerConnectionFactory.warmup creates the default factory in the background', t => {
+  return RTCPeerConnectionFactory.warmup().then(factory => {
+    t.ok(factory instanceof RTCPeerConnectionFactory, 'resolves to an RTCPeerConnectionFactory');
+    t.ok(factory.initializationTime > 0, 'the factory reports its initializationTime');
+    const peerConnectionCount = factory.peerConnectionCount;
+    const pc = new RTCPeerConnection();
+    t.equal(factory.peerConnectionCount, peerConnectionCount + 1, 'the next RTCPeerConnection uses the warmed up factory');
+    pc.close();
+    t.end();
+  });
+});
+
+test('RTCPeerConnectionFactory can be constructed with a task queue thread pool', t => {
+  const factory = new RTCPeerConnectionFactory({ taskQueueThreads: 2 });
+  const pc = new RTCPeerConnection({ factory });
+  pc.addTransceiver('video');
+  return pc.createOffer().then(offer => pc.setLocalDescription(offer)).then(() => {
+    t.pass('negotiates using the pooled task queues');
+    pc.close();
+    t.end();
+  });
+});
+
+test('RTCPeerConnectionFactory dataChannelsOnly supports RTCDataChannels', t => {
+  const factory = new RTCPeerConnectionFactory({ dataChannelsOnly: true });
+  const pc = new RTCPeerConnection({ factory });
+  pc.createDataChannel('test');
+  return pc.createOffer().then(offer => {
+    t.ok(/m=application/.test(offer.sdp), 'the offer includes an application m-section');
+    pc.close();
+    t.end();
+  });
+});
+
+test('RTCPeerConnectionFactory udpBatching connects RTCPeerConnections', async t => {
+  const factory = new RTCPeerConnectionFactory({ udpBatching: true });
+  const [pc1, pc2] = createRTCPeerConnections({ factory }, { factory });
+  const received = sendHello(pc1, pc2);
+  await negotiate(pc1, pc2);
+  t.equal(await received, 'hello', 'exchanges a message over batched UDP sockets');
+  pc1.close();
+  pc2.close();
+  t.end();
+});
+
+test('RTCPeerConnectionFactory networkSocketServer "epoll" connects RTCPeerConnections', async t => {
+  const factory = new RTCPeerConnectionFactory({ networkSocketServer: 'epoll' });
+  const [pc1, pc2] = createRTCPeerConnections({ factory }, { factory });
+  const received = sendHello(pc1, pc2);
+  await negotiate(pc1, pc2);
+  t.equal(await received, 'hello', 'exchanges a message');
+  const stats = factory.networkThreadStats;
+  if (process.platform === 'linux') {
+    t.ok(stats.wakeups > 0, 'counts wakeups');
+    t.ok(stats.iterations > 0, 'counts iterations');
+    t.ok(stats.events >= stats.iterations, 'counts events');
+    t.ok(stats.time >= 0, 'measures time');
+  } else {
+    t.equal(stats, null, 'networkThreadStats is null');
+  }
+  t.equal(new RTCPeerConnectionFactory().networkThreadStats, null,
+    'networkThreadStats is null for the "physical" socket server');
+  pc1.close();
+  pc2.close();
+  t.end();
+});
+
+test('RTCPeerConnectionFactory networkSocketServer "epoll" delivers bursts larger than a socket\'s read limit', async t => {
+  // Each socket reads at most 4 batches of 32 datagrams per event.
+  const count = 1000;
+  const factory = new RTCPeerConnectionFactory({ networkSocketServer: 'epoll' });
+  const [pc1, pc2] = createRTCPeerConnections({ factory }, { factory });
+  const channel = pc1.createDataChannel('burst', { ordered: false });
+  channel.onopen = () => {
+    const message = new Uint8Array(1000);
+    for (let i = 0; i < count; i++) {
+      channel.send(message);
+    }
+  };
+  const received = new Promise(resolve => {
+    let remaining = count;
+    pc2.ondatachannel = ({ channel }) => {
+      channel.onmessage = () => --remaining || resolve(true);
+    };
+  });
+  let timer;
+  const timeout = new Promise(resolve => { timer = setTimeout(() => resolve(false), 5000); });
+  await negotiate(pc1, pc2);
+  t.ok(await Promise.race([received, timeout]), 'receives every message without waiting for other traffic');
+  clearTimeout(timer);
+  pc1.close();
+  pc2.close();
+  t.end();
+});
+
+test('RTCPeerConnectionFactory sharedUdpPort multiplexes RTCPeerConnections over one port', t => {
+  const shared = new RTCPeerConnectionFactory({ sharedUdpPort: 0 });
+  const other = new RTCPeerConnectionFactory();
+
+  async function connect() {
+    const [pc1, pc2] = createRTCPeerConnections({ factory: shared }, { factory: other });
+    const ports = [];
+    pc1.addEventListener('icecandidate', ({ candidate }) => {
+      if (candidate && candidate.protocol === 'udp') {
+        ports.push(candidate.port);
+      }
+    });
+    const received = sendHello(pc1, pc2);
+    await negotiate(pc1, pc2);
+    const data = await received;
+    pc1.close();
+    pc2.close();
+    return { data, ports };
+  }
+
+  return Promise.all([connect(), connect()]).then(results => {
+    results.forEach(({ data }) => t.equal(data, 'hello', 'exchanges a message'));
+    const ports = new Set(results[0].ports.concat(results[1].ports));
+    t.equal(ports.size, 1, 'gathers every UDP candidate on the same port');
+    t.end();
+  });
+});
+
+test('RTCPeerConnectionFactory sharedUdpPort refuses TURN servers over UDP', t => {
+  const factory = new RTCPeerConnectionFactory({ sharedUdpPort: 0 });
+  const turn = { urls: 'turn:turn.example.org', username: 'user', credential: 'password' };
+  t.throws(() => new RTCPeerConnection({ factory, iceServers: [turn] }), /InvalidAccessError/,
+    'the constructor throws');
+  const pc = new RTCPeerConnection({
+    factory,
+    iceServers: [{ ...turn, urls: 'turn:turn.example.org?transport=tcp' }]
+  });
+  t.pass('accepts TURN servers over TCP');
+  t.throws(() => pc.setConfiguration({ iceServers: [turn] }), /InvalidAccessError/,
+    'setConfiguration throws');
+  pc.close();
+  t.end();
+});
+
+test('RTCPeerConnectionFactory cacheNetworks connects RTCPeerConnections', async t => {
+  const factory = new RTCPeerConnectionFactory({
+    cacheNetworks: true,
+    networkInterfaceDenylist: ['docker*', 'veth*']
+  });
+  const [pc1, pc2] = createRTCPeerConnections({ factory }, { factory });
+  const received = sendHello(pc1, pc2);
+  await negotiate(pc1, pc2);
+  t.equal(await received, 'hello', 'exchanges a message');
+  pc1.close();
+  pc2.close();
+  t.end();
+});
+
+test('RTCPeerConnectionFactory iceCandidatePoolSize pre-gathers candidates for RTCPeerConnections', t => {
+  const factory = new RTCPeerConnectionFactory({ iceCandidatePoolSize: 2 });
+  t.deepEqual(factory.iceCandidatePoolStats, { size: 0, hits: 0, misses: 0, expired: 0 },
+    'the pool is initially empty');
+  t.equal(new RTCPeerConnectionFactory().iceCandidatePoolStats, null,
+    'iceCandidatePoolStats is null without a pool');
+
+  function gather() {
+    const pc = new RTCPeerConnection({ factory });
+    const gathered = new Promise(resolve => {
+      pc.onicegatheringstatechange = () => pc.iceGatheringState === 'complete' && resolve();
+    });
+    pc.createDataChannel('test');
+    return pc.createOffer()
+      .then(offer => pc.setLocalDescription(offer))
+      .then(() => gathered)
+      .then(() => pc.close());
+  }
+
+  return gather().then(() => {
+    const stats = factory.iceCandidatePoolStats;
+    t.equal(stats.misses, 1, 'the first RTCPeerConnection misses');
+    t.equal(stats.size, 2, 'and the pool fills');
+    return gather();
+  }).then(() => {
+    const stats = factory.iceCandidatePoolStats;
+    t.equal(stats.hits, 1, 'the second RTCPeerConnection hits');
+    t.equal(stats.size, 2, 'and the pool refills');
+    t.end();
+  });
+});
+
+test('RTCPeerConnectionFactory iceCandidatePoolSize hands pooled candidates to RTCPeerConnections', async t => {
+  const factory = new RTCPeerConnectionFactory({ iceCandidatePoolSize: 1 });
+
+  // The first RTCPeerConnection misses, and configures the pool.
+  const first = new RTCPeerConnection({ factory });
+  const firstGathered = waitForStateChange(first, 'complete', {
+    event: 'icegatheringstatechange',
+    property: 'iceGatheringState'
+  });
+  first.createDataChannel('test');
+  await first.setLocalDescription(await first.createOffer());
+  await firstGathered;
+  first.close();
+
+  const [pc1, pc2] = createRTCPeerConnections({ factory }, {});
+  const gathered = gatherCandidates(pc1);
+  const received = sendHello(pc1, pc2);
+  await negotiate(pc1, pc2);
+  t.equal(factory.iceCandidatePoolStats.hits, 1, 'the second RTCPeerConnection hits');
+  t.ok((await gathered).length > 0, 'emits the pooled candidates');
+  t.ok(/ typ host/.test(pc1.localDescription.sdp), 'includes host candidates in its localDescription');
+  t.equal(await received, 'hello', 'exchanges a message');
+  pc1.close();
+  pc2.close();
+  t.end();
+});
+
+test('RTCPeerConnectionFactory iceCandidatePoolSize respects portRange', async t => {
+  const factory = new RTCPeerConnectionFactory({ iceCandidatePoolSize: 1 });
+  const portRange = { min: 50000, max: 50099 };
+
+  async function gather(configuration) {
+    const pc = new RTCPeerConnection({ factory, ...configuration });
+    const gathered = gatherCandidates(pc);
+    pc.createDataChannel('test');
+    await pc.setLocalDescription(await pc.createOffer());
+    const candidates = await gathered;
+    pc.close();
+    return candidates.filter(({ protocol }) => protocol === 'udp').map(({ port }) => port);
+  }
+
+  await gather({});
+  await gather({ portRange });
+  t.equal(factory.iceCandidatePoolStats.misses, 2, 'an RTCPeerConnection with a different portRange misses');
+
+  const ports = await gather({ portRange });
+  t.equal(factory.iceCandidatePoolStats.hits, 1, 'an RTCPeerConnection with the same portRange hits');
+  t.ok(ports.length > 0, 'gathers UDP candidates');
+  t.ok(ports.every(port => port >= portRange.min && port <= portRange.max),
+    'the pooled candidates are within the portRange');
+  t.end();
+});
+
+test('RTCPeerConnection can be constructed with a factory', t => {
+  const factory = new RTCPeerConnectionFactory();
+  t.equal(factory.peerConnectionCount, 0, 'peerConnectionCount is initially 0');
+  const pc = new RTCPeerConnection({ factory });
+  t.equal(factory.peerConnectionCount, 1, 'peerConnectionCount is 1 once an RTCPeerConnection uses the factory');
+  pc.close();
+  t.equal(factory.peerConnectionCount, 0, 'peerConnectionCount is 0 once the RTCPeerConnection is closed');
+  t.end();
+});
+
+test('RTCPeerConnection getConfiguration includes its factory', t => {
+  const factory = new RTCPeerConnectionFactory();
+  const pc = new RTCPeerConnection({ factory });
+  const configuration = pc.getConfiguration();
+  t.equal(configuration.factory, factory, 'includes the factory');
+  pc.setConfiguration(configuration);
+  t.pass('round-trips through setConfiguration');
+  const defaultPc = new RTCPeerConnection();
+  t.notOk('factory' in defaultPc.getConfiguration(), 'omits the default factory');
+  defaultPc.close();
+  pc.close();
+  t.notOk('factory' in pc.getConfiguration(), 'omits the factory once closed');
+  t.end();
+});
+
+test('RTCPeerConnection throws for a factory that is not an RTCPeerConnectionFactory', t => {
+  t.throws(() => new RTCPeerConnection({ factory: {} }), /TypeError/);
+  t.end();
+});
+
+test('RTCPeerConnectionFactoryPool round-robin', t => {
+  const pool = new RTCPeerConnectionFactoryPool({ size: 2 });
+  const [first, second] = pool.factories;
+  t.equal(pool.next(), first, 'returns the first factory');
+  t.equal(pool.next(), second, 'returns the second factory');
+  t.equal(pool.next(), first, 'returns the first factory again');
+  t.end();
+});
+
+test('RTCPeerConnectionFactoryPool least-loaded', t => {
+  const pool = new RTCPeerConnectionFactoryPool({ size: 2, strategy: 'least-loaded' });
+  const [first, second] = pool.factories;
+  const pc1 = new RTCPeerConnection({ factory: pool.next() });
+  const pc2 = new RTCPeerConnection({ factory: pool.next() });
+  t.equal(first.peerConnectionCount, 1, 'the first factory has one RTCPeerConnection');
+  t.equal(second.peerConnectionCount, 1, 'the second factory has one RTCPeerConnection');
+  pc1.close();
+  t.equal(pool.next(), first, 'returns the factory with the fewest RTCPeerConnections');
+  pc2.close();
+  t.end();
+});
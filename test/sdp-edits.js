@@ -0,0 +1,113 @@
+'use strict';
+
+const test = require('tape');
+
+const { RTCPeerConnection } = require('..');
+
+const { createRTCPeerConnections, doAnswer, doOffer, waitForStateChange } = require('./lib/pc');
+
+function getMediaSections(sdp) {
+  return sdp.split(/\r\n(?=m=)/).slice(1);
+}
+
+function getPayloadType(section, name) {
+  const match = section.match(new RegExp(`a=rtpmap:(\\d+) ${name}/`, 'i'));
+  return match && match[1];
+}
+
+test('createOffer with sdpEdits', async t => {
+  const pc = new RTCPeerConnection({ sdpSemantics: 'unified-plan' });
+  pc.addTransceiver('audio');
+  pc.addTransceiver('video');
+
+  const offer = await pc.createOffer({
+    sdpEdits: [
+      { kind: 'audio', codecs: ['PCMU', 'opus'], fmtp: 'usedtx=1; stereo=1', bandwidth: 64 },
+      { kind: 'video', codecs: ['VP9'] }
+    ]
+  });
+  const [audio, video] = getMediaSections(offer.sdp);
+
+  const formats = audio.split('\r\n')[0].split(' ').slice(3);
+  t.deepEqual(formats.slice(0, 2), [getPayloadType(audio, 'PCMU'), getPayloadType(audio, 'opus')],
+    'the listed codecs come first, in order');
+  t.ok(audio.includes('b=AS:64'), 'sets b=AS');
+  t.ok(new RegExp(`a=fmtp:${getPayloadType(audio, 'opus')} .*stereo=1`).test(audio), 'sets fmtp parameters');
+  t.ok(new RegExp(`a=fmtp:${getPayloadType(audio, 'opus')} .*usedtx=1`).test(audio), 'sets every fmtp parameter');
+  t.equal(video.split('\r\n')[0].split(' ')[3], getPayloadType(video, 'VP9'), 'edits match by kind');
+  t.notOk(video.includes('b=AS'), 'edits only apply to the media sections they match');
+
+  await pc.setLocalDescription(offer);
+  t.ok(pc.localDescription.sdp.includes('b=AS:64'), 'setLocalDescription applies the edited description');
+
+  pc.close();
+  t.end();
+});
+
+test('createOffer with an sdpEdit that removes a media section', async t => {
+  const [pc1, pc2] = createRTCPeerConnections({ sdpSemantics: 'unified-plan' }, { sdpSemantics: 'unified-plan' });
+  pc1.addTransceiver('audio');
+  const { mid } = pc1.addTransceiver('video');
+  const offer = await pc1.createOffer();
+  const videoMid = mid || getMediaSections(offer.sdp)[1].match(/a=mid:(\S+)/)[1];
+
+  const edited = await pc1.createOffer({ sdpEdits: [{ mid: videoMid, remove: true }] });
+  const sections = getMediaSections(edited.sdp);
+  t.equal(sections.length, 1, 'removes the media section');
+  t.ok(sections[0].startsWith('m=audio'), 'keeps the other media section');
+  t.notOk(new RegExp(`a=group:BUNDLE.* ${videoMid}(\\s|$)`).test(edited.sdp), 'removes the mid from the BUNDLE group');
+
+  const connected = waitForStateChange(pc1, 'connected', {
+    event: 'iceconnectionstatechange',
+    property: 'iceConnectionState'
+  });
+  await pc1.setLocalDescription(edited);
+  await pc2.setRemoteDescription(edited);
+  await doAnswer(pc2, pc1);
+  t.equal(getMediaSections(pc2.localDescription.sdp).length, 1, 'the answer has one media section');
+  await connected;
+  t.pass('connects');
+
+  pc1.close();
+  pc2.close();
+  t.end();
+});
+
+test('createAnswer with an sdpEdit that removes a media section', async t => {
+  const [pc1, pc2] = createRTCPeerConnections({ sdpSemantics: 'unified-plan' }, { sdpSemantics: 'unified-plan' });
+  pc1.addTransceiver('audio');
+  pc1.addTransceiver('video');
+  await doOffer(pc1, pc2);
+  const videoMid = getMediaSections(pc1.localDescription.sdp)[1].match(/a=mid:(\S+)/)[1];
+
+  const answer = await pc2.createAnswer({ sdpEdits: [{ mid: videoMid, remove: true }] });
+  const sections = getMediaSections(answer.sdp);
+  t.equal(sections.length, 2, 'keeps every media section of the offer');
+  t.ok(/^m=video 0 /.test(sections[1]), 'rejects the media section');
+  t.notOk(new RegExp(`a=group:BUNDLE.* ${videoMid}(\\s|$)`).test(answer.sdp), 'removes the mid from the BUNDLE group');
+
+  const connected = waitForStateChange(pc1, 'connected', {
+    event: 'iceconnectionstatechange',
+    property: 'iceConnectionState'
+  });
+  await pc2.setLocalDescription(answer);
+  await pc1.setRemoteDescription(answer);
+  await connected;
+  t.pass('connects');
+
+  pc1.close();
+  pc2.close();
+  t.end();
+});
+
+test('createOffer with an invalid sdpEdit', async t => {
+  const pc = new RTCPeerConnection({ sdpSemantics: 'unified-plan' });
+  await pc.createOffer({ sdpEdits: [{ fmtp: '=1' }] }).then(
+    () => t.fail('createOffer should reject'),
+    () => t.pass('rejects malformed fmtp parameters'));
+  await pc.createOffer({ sdpEdits: [{ kind: 'screen' }] }).then(
+    () => t.fail('createOffer should reject'),
+    () => t.pass('rejects an unknown kind'));
+  pc.close();
+  t.end();
+});
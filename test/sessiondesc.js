@@ -55,3 +55,50 @@ test('TODO: cleanup connection', function(t) {
   peer.close();
   t.pass('connection closed');
 });
+
+test('localDescription and remoteDescription reflect added candidates', async function(t) {
+  var pc1 = new RTCPeerConnection({ iceServers: [] });
+  var pc2 = new RTCPeerConnection({ iceServers: [] });
+  pc1.createDataChannel('test');
+
+  var candidate = new Promise(function(resolve) {
+    pc1.onicecandidate = function(event) {
+      if (event.candidate) {
+        resolve(event.candidate);
+      }
+    };
+  });
+  var offer = await pc1.createOffer();
+  await pc1.setLocalDescription(offer);
+  t.equal(pc1.localDescription.sdp, pc1.localDescription.sdp, 'repeated reads agree');
+  await pc2.setRemoteDescription(offer);
+  var before = pc2.remoteDescription.sdp;
+
+  candidate = await candidate;
+  t.ok(pc1.localDescription.sdp.includes(candidate.candidate), 'localDescription includes a gathered candidate');
+  await pc2.addIceCandidate(candidate);
+  t.notEqual(pc2.remoteDescription.sdp, before, 'remoteDescription changes once a candidate is added');
+  t.ok(pc2.remoteDescription.sdp.includes(candidate.candidate), 'remoteDescription includes the added candidate');
+
+  pc1.close();
+  pc2.close();
+  t.end();
+});
+
+test('localDescription reflects a replaced local offer read while it was being set', async function(t) {
+  var pc = new RTCPeerConnection({ iceServers: [] });
+  pc.createDataChannel('test');
+  await pc.setLocalDescription(await pc.createOffer());
+  t.notOk(/m=audio/.test(pc.localDescription.sdp), 'the first offer has no audio m-section');
+
+  pc.addTransceiver('audio');
+  var offer = await pc.createOffer();
+  var set = pc.setLocalDescription(offer);
+  t.ok(pc.localDescription, 'localDescription can be read while the offer is being set');
+  await set;
+  t.equal(pc.signalingState, 'have-local-offer', 'the signaling state did not change');
+  t.ok(/m=audio/.test(pc.localDescription.sdp), 'localDescription is the replacement offer');
+
+  pc.close();
+  t.end();
+});
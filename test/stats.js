@@ -0,0 +1,209 @@
+'use strict';
+
+const test = require('tape');
+
+const { RTCPeerConnection, nonstandard: { RTCAudioSource } } = require('..');
+
+const { negotiateRTCPeerConnections, waitForStateChange } = require('./lib/pc');
+
+async function createConnectedRTCPeerConnections() {
+  const [pc1, pc2] = await negotiateRTCPeerConnections({
+    withPc1(pc1) {
+      pc1.createDataChannel('test');
+    }
+  });
+  await Promise.all([
+    waitForStateChange(pc1, 'connected', { event: 'connectionstatechange', property: 'connectionState' }),
+    waitForStateChange(pc2, 'connected', { event: 'connectionstatechange', property: 'connectionState' })
+  ]);
+  return [pc1, pc2];
+}
+
+test('getStatsBuffer', async t => {
+  const [pc1, pc2] = await createConnectedRTCPeerConnections();
+  const report = await pc1.getStats();
+  const { ids, types, members, values } = await pc1.getStatsBuffer();
+  t.ok(values instanceof Float64Array, 'values is a Float64Array');
+  t.equal(members[0], 'timestamp', 'the first member is "timestamp"');
+  t.equal(ids.length, types.length, 'there is a type for every id');
+  t.equal(values.length, ids.length * members.length, 'there is a value for every id and member');
+  t.deepEqual(new Set(ids), new Set(report.keys()), 'ids matches the keys of the RTCStatsReport');
+  t.ok(ids.every((id, i) => types[i] === report.get(id).type), 'types matches the RTCStatsReport');
+
+  const transport = ids.indexOf(ids.find((id, i) => types[i] === 'transport'));
+  const bytesSent = members.indexOf('bytesSent');
+  t.ok(values[transport * members.length + bytesSent] > 0, 'the transport has sent some bytes');
+  t.ok(Number.isNaN(values[ids.indexOf(ids.find((id, i) => types[i] === 'certificate')) * members.length + bytesSent]),
+    'a missing member is NaN');
+
+  pc1.close();
+  pc2.close();
+  await pc1.getStatsBuffer().then(() => t.fail('getStatsBuffer should reject'), () => t.pass('rejects once closed'));
+  t.end();
+});
+
+test('getStats with an RTCStatsFilter', async t => {
+  const [pc1, pc2] = await createConnectedRTCPeerConnections();
+  const report = await pc1.getStats({ types: ['transport', 'data-channel'], members: ['bytesSent', 'label'] });
+  const stats = [...report.values()];
+  t.ok(stats.length > 0, 'the report is not empty');
+  t.ok(stats.every(stats => stats.type === 'transport' || stats.type === 'data-channel'), 'only selected types are included');
+  t.ok(stats.every(stats => Object.keys(stats).every(key => ['id', 'timestamp', 'type', 'bytesSent', 'label'].includes(key))),
+    'only selected members are included');
+  t.ok(stats.some(stats => stats.bytesSent > 0), 'selected members are converted');
+
+  const { ids, types, members, values } = await pc1.getStatsBuffer({ types: ['transport'], members: ['bytesSent', 'bytesReceived', 'nonexistent'] });
+  t.deepEqual(members, ['timestamp', 'bytesSent', 'bytesReceived', 'nonexistent'], 'the selected members are the columns');
+  t.ok(types.every(type => type === 'transport'), 'only selected types are rows');
+  t.equal(values.length, ids.length * members.length, 'there is a value for every id and member');
+  t.ok(Number.isNaN(values[3]), 'a member no stats object defines is NaN');
+
+  await pc1.getStats({ types: 'transport' }).then(() => t.fail('getStats should reject'), () => t.pass('rejects an invalid RTCStatsFilter'));
+
+  pc1.close();
+  pc2.close();
+  t.end();
+});
+
+test('RTCPeerConnection.collectStats', async t => {
+  const [pc1, pc2] = await createConnectedRTCPeerConnections();
+  const pc3 = new RTCPeerConnection();
+  pc3.close();
+
+  const { ids, types, members, values, connections } = await RTCPeerConnection.collectStats([pc1, pc2, pc3], {
+    types: ['transport'],
+    members: ['bytesSent']
+  });
+  t.ok(connections instanceof Uint32Array, 'connections is a Uint32Array');
+  t.equal(connections.length, ids.length, 'there is a connection for every id');
+  t.ok(connections.includes(0) && connections.includes(1), 'both open RTCPeerConnections have rows');
+  t.notOk(connections.includes(2), 'the closed RTCPeerConnection has no rows');
+  t.ok(types.every(type => type === 'transport'), 'only selected types are rows');
+  t.deepEqual(members, ['timestamp', 'bytesSent'], 'the selected members are the columns');
+  t.equal(values.length, ids.length * members.length, 'there is a value for every id and member');
+
+  const empty = await RTCPeerConnection.collectStats([]);
+  t.equal(empty.ids.length, 0, 'collecting the stats of no RTCPeerConnections resolves an empty buffer');
+
+  await RTCPeerConnection.collectStats([{}]).then(() => t.fail('collectStats should reject'),
+    () => t.pass('rejects for an object that is not an RTCPeerConnection'));
+
+  pc1.close();
+  pc2.close();
+  t.end();
+});
+
+test('subscribeStats', async t => {
+  const [pc1, pc2] = await createConnectedRTCPeerConnections();
+  t.throws(() => pc1.subscribeStats({ intervalMs: 0 }), /TypeError/, 'throws for an intervalMs of 0');
+
+  const events = [];
+  const twoEvents = new Promise(resolve => {
+    pc1.onstats = event => {
+      events.push(event);
+      if (events.length === 2) {
+        resolve();
+      }
+    };
+  });
+  const channel = pc1.createDataChannel('stats');
+  const interval = setInterval(() => {
+    if (channel.readyState === 'open') {
+      channel.send('hello');
+    }
+  }, 10);
+  pc1.subscribeStats({ intervalMs: 50, types: ['transport'], members: ['bytesSent'] });
+  await twoEvents;
+  pc1.unsubscribeStats();
+  clearInterval(interval);
+
+  const [first, second] = events;
+  t.equal(first.type, 'stats', 'the event type is "stats"');
+  t.deepEqual(first.members, ['timestamp', 'bytesSent', 'sendBitrate', 'receiveBitrate', 'packetLossFraction', 'frameRate'],
+    'the columns are the selected members and the rates');
+  t.ok(first.types.every(type => type === 'transport'), 'only selected types are rows');
+  t.ok(first.values[1] > 0, 'the first event has every value');
+  t.ok(Number.isNaN(first.values[2]), 'the first event has no rates');
+  t.ok(second.values[1] > first.values[1], 'the second event has the changed value');
+  t.ok(second.values[2] > 0, 'the second event has the send bitrate');
+
+  pc1.close();
+  pc2.close();
+  t.throws(() => pc1.subscribeStats(), /InvalidStateError/, 'throws once closed');
+  t.end();
+});
+
+test('subscribeStats without members selects every numeric member', async t => {
+  const [pc1, pc2] = await createConnectedRTCPeerConnections();
+  const event = new Promise(resolve => { pc1.onstats = resolve; });
+  pc1.subscribeStats({ intervalMs: 50, types: ['transport'] });
+  const { members } = await event;
+  pc1.unsubscribeStats();
+
+  t.equal(members[0], 'timestamp', 'the first column is the timestamp');
+  t.ok(members.includes('bytesSent') && members.includes('bytesReceived'), 'selects every numeric member');
+  t.deepEqual(members.slice(-4), ['sendBitrate', 'receiveBitrate', 'packetLossFraction', 'frameRate'],
+    'the rates come last');
+
+  pc1.close();
+  pc2.close();
+  t.end();
+});
+
+test('RTCRtpSender and RTCRtpReceiver getStats', async t => {
+  const source = new RTCAudioSource();
+  const track = source.createTrack();
+  const [pc1, pc2] = await negotiateRTCPeerConnections({
+    withPc1(pc1) {
+      pc1.createDataChannel('test');
+      pc1.addTrack(track);
+    }
+  });
+  await Promise.all([
+    waitForStateChange(pc1, 'connected', { event: 'connectionstatechange', property: 'connectionState' }),
+    waitForStateChange(pc2, 'connected', { event: 'connectionstatechange', property: 'connectionState' })
+  ]);
+
+  const [sender] = pc1.getSenders();
+  const [receiver] = pc2.getReceivers();
+  const senderReport = await sender.getStats();
+  const receiverReport = await receiver.getStats();
+  const senderTypes = [...senderReport.values()].map(stats => stats.type);
+  const receiverTypes = [...receiverReport.values()].map(stats => stats.type);
+  t.ok(senderReport.size < (await pc1.getStats()).size, 'the RTCRtpSender\'s report is a subset of the RTCPeerConnection\'s');
+  t.notOk(senderTypes.includes('data-channel'), 'the RTCRtpSender\'s report excludes unrelated stats');
+  t.notOk(senderTypes.includes('inbound-rtp'), 'the RTCRtpSender\'s report excludes inbound-rtp');
+  t.notOk(receiverTypes.includes('data-channel'), 'the RTCRtpReceiver\'s report excludes unrelated stats');
+  t.notOk(receiverTypes.includes('outbound-rtp'), 'the RTCRtpReceiver\'s report excludes outbound-rtp');
+
+  const filtered = await pc2.getTransceivers()[0].receiver.getStats({ types: ['transport'] });
+  t.ok([...filtered.values()].every(stats => stats.type === 'transport'), 'an RTCStatsFilter applies');
+
+  pc1.close();
+  pc2.close();
+  track.stop();
+  await sender.getStats().then(() => t.fail('getStats should reject'), () => t.pass('rejects once closed'));
+  t.end();
+});
+
+test('getLegacyStats', async t => {
+  const [pc1, pc2] = await createConnectedRTCPeerConnections();
+  const reports = await pc1.getLegacyStats();
+  t.ok(Array.isArray(reports) && reports.length > 0, 'resolves to a non-empty Array');
+  t.ok(reports.every(report => typeof report.id === 'string' && typeof report.type === 'string'),
+    'every report has an id and a type');
+  t.ok(reports.every(report => typeof report.timestamp === 'number'), 'every report has a timestamp');
+
+  const legacy = await new Promise((resolve, reject) => pc1.getStats(resolve, reject));
+  t.deepEqual(reports.map(report => report.type).sort(), legacy.result().map(report => report.type).sort(),
+    'has the same reports as the legacy getStats');
+  const [report] = legacy.result();
+  const [name] = report.names();
+  t.equal(typeof report.stat(name), 'string', 'stat finds a stat by name');
+  t.equal(report.stat('nonexistent'), undefined, 'stat returns undefined for a missing stat');
+
+  pc1.close();
+  pc2.close();
+  await pc1.getLegacyStats().then(() => t.fail('getLegacyStats should reject'), () => t.pass('rejects once closed'));
+  t.end();
+});